@@ -0,0 +1,22 @@
+/*
+ -----------------------------------------------------------------------------------
+ Laboratoire : ASD1 Cube magique
+ Fichier     : base_shapes.cpp
+ Auteur(s)   : Jorge-André Fulgencio Esteves <jorgeand.fulgencioesteves@heig-vd.ch>,
+               Florian Schaufelberger <florian.schaufelberger@heig-vd.ch>,
+               Jonathan Zaehringer <jonathan.zaehringer@heig-vd.ch>
+
+ Date        : 27.03.2018
+
+ Compilateur : Apple LLVM version 9.0.0 (clang-900.0.39.2)
+               gcc version 5.4.0 20160609 (Ubuntu 5.4.0-6ubuntu1~16.04.9)
+               gcc version 7.2.0 (Debian 7.2.0-19)
+ -----------------------------------------------------------------------------------
+*/
+#include "base_shapes.h"
+
+// Definitions des tables constexpr (necessaires lorsqu'elles sont odr-utilisees)
+constexpr int CBase::SHAPES[1][3][3];
+constexpr int LBase::SHAPES[24][4][3];
+constexpr int TBase::SHAPES[12][4][3];
+constexpr int SBase::SHAPES[12][4][3];
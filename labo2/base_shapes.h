@@ -0,0 +1,151 @@
+/*
+ -----------------------------------------------------------------------------------
+ Laboratoire : ASD1 Cube magique
+ Fichier     : base_shapes.h
+ Auteur(s)   : Jorge-André Fulgencio Esteves <jorgeand.fulgencioesteves@heig-vd.ch>,
+               Florian Schaufelberger <florian.schaufelberger@heig-vd.ch>,
+               Jonathan Zaehringer <jonathan.zaehringer@heig-vd.ch>
+
+ Date        : 27.03.2018
+
+ Compilateur : Apple LLVM version 9.0.0 (clang-900.0.39.2)
+               gcc version 5.4.0 20160609 (Ubuntu 5.4.0-6ubuntu1~16.04.9)
+               gcc version 7.2.0 (Debian 7.2.0-19)
+ -----------------------------------------------------------------------------------
+*/
+#ifndef BASE_SHAPES_H
+#define BASE_SHAPES_H
+
+#include <cstddef>
+
+#include "shape.h"
+
+/**
+ * Orientations de base des pieces, exprimees en cubes unitaires {x, y, z}.
+ *
+ * Les tables sont constexpr afin d'etre utilisables aussi bien par la
+ * generation dynamique des positions (Piece::generateAllPositions) que par
+ * le solveur specialise a la compilation (fixed_solver.h).
+ */
+struct CBase {
+    static constexpr char NAME = 'C';
+    static constexpr int SHAPES[1][3][3] = {
+        {{0,0,0}, {1,0,0}, {0,1,0}},
+        /*
+        {{0,0,0}, {0,1,0}, {1,1,0}},
+        {{0,0,0}, {1,0,0}, {1,1,0}},
+        {{1,0,0}, {0,1,0}, {1,1,0}},
+
+        {{0,1,0}, {0,0,0}, {0,1,1}},
+        {{0,1,0}, {0,0,0}, {0,0,1}},
+
+        {{0,0,0}, {1,0,0}, {0,0,1}},
+        {{0,0,0}, {1,0,0}, {1,0,1}},
+
+        {{0,1,1}, {0,0,1}, {0,1,0}},
+        {{0,1,1}, {0,0,1}, {0,0,0}},
+
+        {{0,0,1}, {1,0,1}, {0,0,0}},
+        {{0,0,1}, {1,0,1}, {1,0,0}},
+        */
+    };
+};
+
+struct LBase {
+    static constexpr char NAME = 'L';
+    static constexpr int SHAPES[24][4][3] = {
+        {{0,0,0}, {1,0,0}, {2,0,0}, {0,1,0}},
+        {{0,0,0}, {1,0,0}, {2,0,0}, {0,0,1}},
+        {{0,0,0}, {0,1,0}, {1,1,0}, {2,1,0}},
+        {{0,0,0}, {1,0,1}, {2,0,1}, {0,0,1}},
+
+        {{0,0,0}, {1,0,0}, {0,1,0}, {0,2,0}},
+        {{0,0,0}, {0,1,0}, {0,2,0}, {0,0,1}},
+        {{0,0,0}, {1,0,0}, {1,1,0}, {1,2,0}},
+        {{0,0,0}, {0,0,1}, {0,1,1}, {0,2,1}},
+
+        {{0,0,0}, {0,1,0}, {0,2,0}, {1,2,0}},
+        {{0,0,0}, {0,1,0}, {0,2,0}, {0,2,1}},
+        {{0,2,0}, {1,2,0}, {1,1,0}, {1,0,0}},
+        {{0,2,0}, {0,2,1}, {0,1,1}, {0,0,1}},
+
+        {{0,0,0}, {0,1,0}, {0,1,1}, {0,1,2}},
+        {{0,1,0}, {1,1,0}, {2,1,0}, {2,0,0}},
+        {{0,0,0}, {1,0,0}, {2,0,0}, {2,1,0}},
+        {{0,0,0}, {1,0,0}, {2,0,0}, {2,0,1}},
+
+        {{0,0,0}, {0,0,1}, {0,0,2}, {1,0,2}},
+        {{0,0,0}, {0,0,1}, {0,0,2}, {0,1,2}},
+        {{1,0,0}, {1,0,1}, {1,0,2}, {0,0,2}},
+        {{0,1,0}, {0,1,1}, {0,1,2}, {0,0,2}},
+
+        {{0,0,1}, {1,0,1}, {2,0,1}, {2,0,0}},
+        {{0,0,2}, {0,0,1}, {0,0,0}, {1,0,0}},
+        {{0,1,0}, {0,0,0}, {0,0,1}, {0,0,2}},
+        {{0,0,0}, {1,0,0}, {1,0,1}, {1,0,2}},
+    };
+};
+
+struct TBase {
+    static constexpr char NAME = 'T';
+    static constexpr int SHAPES[12][4][3] = {
+        {{0,0,0}, {1,0,0}, {2,0,0}, {1,1,0}},
+        {{0,1,0}, {1,1,0}, {2,1,0}, {1,0,0}},
+
+        {{0,0,0}, {0,1,0}, {0,2,0}, {1,1,0}},
+        {{1,0,0}, {1,1,0}, {1,2,0}, {0,1,0}},
+
+        {{0,0,0}, {1,0,0}, {2,0,0}, {1,0,1}},
+        {{0,0,1}, {1,0,1}, {2,0,1}, {1,0,0}},
+
+        {{0,0,0}, {0,0,1}, {0,0,2}, {1,0,1}},
+        {{0,0,0}, {0,0,1}, {0,0,2}, {0,1,1}},
+
+        {{1,0,0}, {1,0,1}, {1,0,2}, {0,0,1}},
+        {{0,1,0}, {0,1,1}, {0,1,2}, {0,0,1}},
+
+        {{0,0,1}, {0,1,1}, {0,2,1}, {0,1,0}},
+        {{0,0,0}, {0,1,0}, {0,2,0}, {0,1,1}},
+    };
+};
+
+struct SBase {
+    static constexpr char NAME = 'S';
+    static constexpr int SHAPES[12][4][3] = {
+        {{0,0,1}, {1,0,1}, {1,0,0}, {2,0,0}},
+        {{0,0,0}, {0,0,1}, {1,0,1}, {1,0,2}},
+
+        {{0,0,0}, {0,1,0}, {0,1,1}, {0,2,1}},
+        {{0,1,0}, {0,1,1}, {0,0,1}, {0,0,2}},
+
+        {{0,0,0}, {1,0,0}, {1,0,1}, {2,0,1}},
+        {{1,0,0}, {1,0,1}, {0,0,1}, {0,0,2}},
+
+        {{0,0,1}, {0,1,1}, {0,1,0}, {0,2,0}},
+        {{0,0,0}, {0,0,1}, {0,1,1}, {0,1,2}},
+
+        {{0,0,0}, {0,1,0}, {1,1,0}, {1,2,0}},
+        {{0,1,0}, {1,1,0}, {1,0,0}, {2,0,0}},
+
+        {{1,0,0}, {1,1,0}, {0,1,0}, {0,2,0}},
+        {{0,0,0}, {1,0,0}, {1,1,0}, {2,1,0}},
+    };
+};
+
+/**
+ * Conversion d'une table constexpr d'orientations en Shapes
+ */
+template <std::size_t NbShapes, std::size_t NbCubes>
+Shapes toShapes(const int (&base)[NbShapes][NbCubes][3]) {
+    Shapes shapes;
+    for(std::size_t s = 0; s < NbShapes; s++) {
+        Shape shape;
+        for(std::size_t c = 0; c < NbCubes; c++) {
+            shape.push_back(Point{base[s][c][0], base[s][c][1], base[s][c][2]});
+        }
+        shapes.push_back(shape);
+    }
+    return shapes;
+}
+
+#endif
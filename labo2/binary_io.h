@@ -0,0 +1,77 @@
+/*
+ -----------------------------------------------------------------------------------
+ Laboratoire : ASD1 Cube magique
+ Fichier     : binary_io.h
+ Auteur(s)   : Jorge-André Fulgencio Esteves <jorgeand.fulgencioesteves@heig-vd.ch>,
+               Florian Schaufelberger <florian.schaufelberger@heig-vd.ch>,
+               Jonathan Zaehringer <jonathan.zaehringer@heig-vd.ch>
+
+ Date        : 27.03.2018
+
+ Compilateur : Apple LLVM version 9.0.0 (clang-900.0.39.2)
+               gcc version 5.4.0 20160609 (Ubuntu 5.4.0-6ubuntu1~16.04.9)
+               gcc version 7.2.0 (Debian 7.2.0-19)
+ -----------------------------------------------------------------------------------
+*/
+#ifndef BINARY_IO_H
+#define BINARY_IO_H
+
+#include <iostream>
+#include <stdexcept>
+#include <algorithm>
+
+/**
+ * Signature de 8 caracteres en tete de chaque fichier binaire du projet
+ * (point de reprise, shard, diagramme, index, table de pieces).
+ */
+typedef char FileMagic[8];
+
+/**
+ * @brief Ecriture brute d'une valeur, dans l'ordre des octets de la machine
+ */
+template <typename T>
+void writeBinary(std::ostream& file, const T& value) {
+    file.write(reinterpret_cast<const char*>(&value), sizeof(T));
+}
+
+/**
+ * @brief Lecture de size octets
+ *
+ * @exception std::runtime_error si le flux est tronque
+ */
+inline void readBinary(std::istream& file, char* data, size_t size) {
+    if(!file.read(data, std::streamsize(size))) {
+        throw std::runtime_error("lecture binaire : fichier tronque");
+    }
+}
+
+/**
+ * @brief Relecture d'une valeur ecrite par writeBinary
+ *
+ * @exception std::runtime_error si le flux est tronque
+ */
+template <typename T>
+T readBinary(std::istream& file) {
+    T value;
+    readBinary(file, reinterpret_cast<char*>(&value), sizeof(T));
+    return value;
+}
+
+/**
+ * @brief Ecriture de la signature en tete de fichier
+ */
+inline void writeMagic(std::ostream& file, const FileMagic& magic) {
+    file.write(magic, sizeof(FileMagic));
+}
+
+/**
+ * @brief Lecture et controle de la signature en tete de fichier
+ *
+ * @return false si le fichier est trop court ou porte une autre signature
+ */
+inline bool readMagic(std::istream& file, const FileMagic& magic) {
+    char found[sizeof(FileMagic)];
+    return file.read(found, sizeof(found)) && std::equal(found, found + sizeof(found), magic);
+}
+
+#endif
@@ -17,29 +17,11 @@
 #include <iostream>
 
 #include "c.h"
+#include "base_shapes.h"
 
 using namespace std;
 
-Shapes C::POSITION_BASE = {
-    Shape{Point{0,0,0}, Point{1,0,0}, Point{0,1,0}},
-    /*
-    Shape{Point{0,0,0}, Point{0,1,0}, Point{1,1,0}},
-    Shape{Point{0,0,0}, Point{1,0,0}, Point{1,1,0}},
-    Shape{Point{1,0,0}, Point{0,1,0}, Point{1,1,0}},
-
-    Shape{Point{0,1,0}, Point{0,0,0}, Point{0,1,1}},
-    Shape{Point{0,1,0}, Point{0,0,0}, Point{0,0,1}},
-
-    Shape{Point{0,0,0}, Point{1,0,0}, Point{0,0,1}},
-    Shape{Point{0,0,0}, Point{1,0,0}, Point{1,0,1}},
-
-    Shape{Point{0,1,1}, Point{0,0,1}, Point{0,1,0}},
-    Shape{Point{0,1,1}, Point{0,0,1}, Point{0,0,0}},
-
-    Shape{Point{0,0,1}, Point{1,0,1}, Point{0,0,0}},
-    Shape{Point{0,0,1}, Point{1,0,1}, Point{1,0,0}},
-    */
-};
+Shapes C::POSITION_BASE = toShapes(CBase::SHAPES);
 
 Shapes C::positions;
 vector<uint_fast32_t> C::fast_positions;
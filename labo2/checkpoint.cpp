@@ -0,0 +1,102 @@
+/*
+ -----------------------------------------------------------------------------------
+ Laboratoire : ASD1 Cube magique
+ Fichier     : checkpoint.cpp
+ Auteur(s)   : Jorge-André Fulgencio Esteves <jorgeand.fulgencioesteves@heig-vd.ch>,
+               Florian Schaufelberger <florian.schaufelberger@heig-vd.ch>,
+               Jonathan Zaehringer <jonathan.zaehringer@heig-vd.ch>
+
+ Date        : 27.03.2018
+
+ Compilateur : Apple LLVM version 9.0.0 (clang-900.0.39.2)
+               gcc version 5.4.0 20160609 (Ubuntu 5.4.0-6ubuntu1~16.04.9)
+               gcc version 7.2.0 (Debian 7.2.0-19)
+ -----------------------------------------------------------------------------------
+*/
+#include <fstream>
+#include <stdexcept>
+#include <cstdio>
+#include <cstdint>
+#include <algorithm>
+
+#include "checkpoint.h"
+#include "binary_io.h"
+
+using namespace std;
+
+namespace {
+    const FileMagic MAGIC = {'A', 'S', 'D', 'C', 'K', 'P', 'T', '1'};
+}
+
+void writePuzzles(ostream& file, const Puzzles& puzzles) {
+    writeBinary<uint64_t>(file, puzzles.size());
+    for(const Puzzle& puzzle : puzzles) {
+        writeBinary<uint8_t>(file, uint8_t(puzzle.getPieces().size()));
+        for(const Piece& p : puzzle.getPieces()) {
+            writeBinary<uint32_t>(file, uint32_t(p.getMask()));
+            writeBinary<uint8_t>(file, uint8_t(p.getId()));
+            writeBinary<char>(file, p.getName());
+        }
+    }
+}
+
+void readPuzzles(istream& file, Puzzles& puzzles) {
+    puzzles.clear();
+
+    // Un Puzzle a la fois : un nombre corrompu bute sur la fin du flux au lieu d'allouer d'avance
+    for(uint64_t n = readBinary<uint64_t>(file); n != 0; n--) {
+        Puzzle puzzle;
+        uint8_t nbPieces = readBinary<uint8_t>(file);
+        for(uint8_t i = 0; i < nbPieces; i++) {
+            uint_fast32_t mask = readBinary<uint32_t>(file);
+            unsigned id = readBinary<uint8_t>(file);
+            char name = readBinary<char>(file);
+            if(mask == 0 || mask >> 27 != 0 || !puzzle.tryToInsert(Piece(toShape(mask), mask, id, name))) {
+                throw runtime_error("readPuzzles : piece invalide ou qui en chevauche une autre");
+            }
+        }
+        puzzles.push_back(puzzle);
+    }
+}
+
+void saveCheckpoint(const string& fileName, const Checkpoint& checkpoint) {
+    const string tmpName = fileName + ".tmp";
+    ofstream file(tmpName, ios::binary | ios::trunc);
+
+    writeMagic(file, MAGIC);
+    writeBinary<uint64_t>(file, checkpoint.combination);
+    writeBinary<uint64_t>(file, checkpoint.nbCombinations);
+    writeBinary<uint8_t>(file, uint8_t(checkpoint.stack.size()));
+    for(size_t i : checkpoint.stack) {
+        writeBinary<uint32_t>(file, uint32_t(i));
+    }
+    writePuzzles(file, checkpoint.current);
+    writePuzzles(file, checkpoint.solutions);
+
+    file.close();
+    if(!file || rename(tmpName.c_str(), fileName.c_str()) != 0) {
+        throw runtime_error("saveCheckpoint : ecriture impossible de " + fileName);
+    }
+}
+
+bool loadCheckpoint(const string& fileName, Checkpoint& checkpoint) {
+    ifstream file(fileName, ios::binary);
+    if(!file) {
+        return false;
+    }
+
+    if(!readMagic(file, MAGIC)) {
+        throw runtime_error("loadCheckpoint : " + fileName + " n'est pas un point de reprise valide");
+    }
+
+    checkpoint.combination = size_t(readBinary<uint64_t>(file));
+    checkpoint.nbCombinations = size_t(readBinary<uint64_t>(file));
+    checkpoint.stack.resize(readBinary<uint8_t>(file));
+    for(size_t& i : checkpoint.stack) {
+        i = readBinary<uint32_t>(file);
+    }
+    readPuzzles(file, checkpoint.current);
+    readPuzzles(file, checkpoint.solutions);
+
+    return true;
+}
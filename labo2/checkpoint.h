@@ -0,0 +1,69 @@
+/*
+ -----------------------------------------------------------------------------------
+ Laboratoire : ASD1 Cube magique
+ Fichier     : checkpoint.h
+ Auteur(s)   : Jorge-André Fulgencio Esteves <jorgeand.fulgencioesteves@heig-vd.ch>,
+               Florian Schaufelberger <florian.schaufelberger@heig-vd.ch>,
+               Jonathan Zaehringer <jonathan.zaehringer@heig-vd.ch>
+
+ Date        : 27.03.2018
+
+ Compilateur : Apple LLVM version 9.0.0 (clang-900.0.39.2)
+               gcc version 5.4.0 20160609 (Ubuntu 5.4.0-6ubuntu1~16.04.9)
+               gcc version 7.2.0 (Debian 7.2.0-19)
+ -----------------------------------------------------------------------------------
+*/
+#ifndef CHECKPOINT_H
+#define CHECKPOINT_H
+
+#include <vector>
+#include <string>
+#include <iostream>
+
+#include "puzzle.h"
+
+/**
+ * Etat complet d'une recherche megaBruteForce, suffisant pour la reprendre
+ * exactement la ou elle s'est arretee.
+ */
+struct Checkpoint {
+    size_t combination;          // indice de la combinaison en cours
+    size_t nbCombinations;       // nombre total de combinaisons (controle)
+    std::vector<size_t> stack;   // pile de la recherche en profondeur
+    Puzzles current;             // solutions deja trouvees pour la combinaison en cours
+    Puzzles solutions;           // solutions emises pour les combinaisons terminees
+};
+
+/**
+ * @brief Ecriture d'un point de reprise
+ *
+ * Le fichier est ecrit a cote puis renomme, un arret brutal pendant
+ * l'ecriture laisse donc le point de reprise precedent intact.
+ *
+ * @exception std::runtime_error si le fichier ne peut pas etre ecrit
+ */
+void saveCheckpoint(const std::string& fileName, const Checkpoint& checkpoint);
+
+/**
+ * @brief Lecture d'un point de reprise
+ *
+ * @return false si le fichier n'existe pas
+ *
+ * @exception std::runtime_error si le fichier est corrompu ou d'une autre version
+ */
+bool loadCheckpoint(const std::string& fileName, Checkpoint& checkpoint);
+
+/**
+ * @brief Serialisation binaire compacte d'une liste de Puzzle (6 octets par piece)
+ */
+void writePuzzles(std::ostream& os, const Puzzles& puzzles);
+
+/**
+ * @brief Relecture d'une liste de Puzzle ecrite par writePuzzles
+ *
+ * @exception std::runtime_error si le flux est tronque ou si une piece est invalide
+ *            (hors du cube, vide ou chevauchant une autre piece du meme Puzzle)
+ */
+void readPuzzles(std::istream& is, Puzzles& puzzles);
+
+#endif
@@ -0,0 +1,155 @@
+/*
+ -----------------------------------------------------------------------------------
+ Laboratoire : ASD1 Cube magique
+ Fichier     : combination_summary.cpp
+ Auteur(s)   : Jorge-André Fulgencio Esteves <jorgeand.fulgencioesteves@heig-vd.ch>,
+               Florian Schaufelberger <florian.schaufelberger@heig-vd.ch>,
+               Jonathan Zaehringer <jonathan.zaehringer@heig-vd.ch>
+
+ Date        : 27.03.2018
+
+ Compilateur : Apple LLVM version 9.0.0 (clang-900.0.39.2)
+               gcc version 5.4.0 20160609 (Ubuntu 5.4.0-6ubuntu1~16.04.9)
+               gcc version 7.2.0 (Debian 7.2.0-19)
+ -----------------------------------------------------------------------------------
+*/
+#include <algorithm>
+#include <chrono>
+#include <set>
+#include <map>
+#include <functional>
+#include <stdexcept>
+#include <cstdint>
+
+#include "combination_summary.h"
+#include "heuristic_search.h"
+#include "symmetry.h"
+
+using namespace std;
+
+namespace {
+    typedef vector<uint64_t> Key;   // (nom << 32) | placement de chaque piece, trie
+
+    // Plus petite image d'une solution par les 48 symetries du cube
+    Key canonical(const Puzzle& puzzle) {
+        Key best;
+        for(size_t g = 0; g < NB_SYMMETRIES; g++) {
+            Key image;
+            for(const Piece& p : puzzle.getPieces()) {
+                image.push_back((uint64_t(uint8_t(p.getName())) << 32) | transform(p.getMask(), g));
+            }
+            sort(image.begin(), image.end());
+            if(g == 0 || image < best) {
+                best = image;
+            }
+        }
+        return best;
+    }
+
+    CombinationSummary summarize(const ArrPieces& combination) {
+        CombinationSummary summary{"", 0, 0, 0, 0, 0};
+        map<char, size_t> multiplicity;
+        for(const Pieces& p : combination) {
+            summary.pieces += p.at(0).getName();
+            multiplicity[p.at(0).getName()]++;
+        }
+
+        const auto start = chrono::steady_clock::now();
+        HeuristicSearch search(combination, HeuristicSearch::Options{true, true});
+        Puzzles solutions;
+        search.solve(solutions);
+        summary.seconds = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+        summary.nodes = search.nodes();
+
+        summary.distinctCount = solutions.size();
+        summary.rawCount = solutions.size();
+        for(const auto& m : multiplicity) {
+            for(size_t k = 2; k <= m.second; k++) {
+                summary.rawCount *= k;
+            }
+        }
+
+        set<Key> classes;
+        for(const Puzzle& p : solutions) {
+            classes.insert(canonical(p));
+        }
+        summary.symmetricCount = classes.size();
+
+        return summary;
+    }
+
+    typedef function<bool(const CombinationSummary&, const CombinationSummary&)> SummaryOrder;
+
+    // Ordre croissant designe par une cle sans le '-', nullptr si la cle est inconnue
+    const SummaryOrder* findOrder(const string& field) {
+        static const map<string, SummaryOrder> orders = {
+            {"pieces",    [](const CombinationSummary& a, const CombinationSummary& b) { return a.pieces < b.pieces; }},
+            {"raw",       [](const CombinationSummary& a, const CombinationSummary& b) { return a.rawCount < b.rawCount; }},
+            {"distinct",  [](const CombinationSummary& a, const CombinationSummary& b) { return a.distinctCount < b.distinctCount; }},
+            {"symmetric", [](const CombinationSummary& a, const CombinationSummary& b) { return a.symmetricCount < b.symmetricCount; }},
+            {"nodes",     [](const CombinationSummary& a, const CombinationSummary& b) { return a.nodes < b.nodes; }},
+            {"time",      [](const CombinationSummary& a, const CombinationSummary& b) { return a.seconds < b.seconds; }},
+        };
+
+        auto it = orders.find(field);
+        return it == orders.end() ? nullptr : &it->second;
+    }
+}
+
+vector<CombinationSummary> summarizeCombinations(ThreadPool& pool, const vector<ArrPieces>& allCombinations) {
+    vector<CombinationSummary> summaries(allCombinations.size());
+    vector<string> errors(allCombinations.size());
+
+    pool.parallelFor(allCombinations.size(), [&](size_t i) {
+        try {
+            summaries[i] = summarize(allCombinations[i]);
+        } catch(const exception& e) {
+            errors[i] = e.what();
+        }
+    });
+
+    for(const string& e : errors) {
+        if(!e.empty()) {
+            throw runtime_error("summarizeCombinations : " + e);
+        }
+    }
+    return summaries;
+}
+
+bool isSortKey(const string& key) {
+    return findOrder(!key.empty() && key[0] == '-' ? key.substr(1) : key) != nullptr;
+}
+
+void sortSummaries(vector<CombinationSummary>& summaries, const string& key) {
+    const bool descending = !key.empty() && key[0] == '-';
+    const SummaryOrder* order = findOrder(descending ? key.substr(1) : key);
+    if(!order) {
+        throw invalid_argument("sortSummaries : cle inconnue " + key);
+    }
+    const auto& less = *order;
+    if(descending) {
+        stable_sort(summaries.begin(), summaries.end(), [&less](const CombinationSummary& a, const CombinationSummary& b) { return less(b, a); });
+    } else {
+        stable_sort(summaries.begin(), summaries.end(), less);
+    }
+}
+
+void writeCsv(ostream& os, const vector<CombinationSummary>& summaries) {
+    os << "pieces,raw,distinct,symmetric,nodes,seconds\n";
+    for(const CombinationSummary& s : summaries) {
+        os << s.pieces << "," << s.rawCount << "," << s.distinctCount << "," << s.symmetricCount << ","
+           << s.nodes << "," << s.seconds << "\n";
+    }
+}
+
+void writeJson(ostream& os, const vector<CombinationSummary>& summaries) {
+    os << "[";
+    for(size_t i = 0; i < summaries.size(); i++) {
+        const CombinationSummary& s = summaries[i];
+        os << (i == 0 ? "\n" : ",\n")
+           << "  {\"pieces\": \"" << s.pieces << "\", \"raw\": " << s.rawCount
+           << ", \"distinct\": " << s.distinctCount << ", \"symmetric\": " << s.symmetricCount
+           << ", \"nodes\": " << s.nodes << ", \"seconds\": " << s.seconds << "}";
+    }
+    os << "\n]\n";
+}
@@ -0,0 +1,69 @@
+/*
+ -----------------------------------------------------------------------------------
+ Laboratoire : ASD1 Cube magique
+ Fichier     : combination_summary.h
+ Auteur(s)   : Jorge-André Fulgencio Esteves <jorgeand.fulgencioesteves@heig-vd.ch>,
+               Florian Schaufelberger <florian.schaufelberger@heig-vd.ch>,
+               Jonathan Zaehringer <jonathan.zaehringer@heig-vd.ch>
+
+ Date        : 27.03.2018
+
+ Compilateur : Apple LLVM version 9.0.0 (clang-900.0.39.2)
+               gcc version 5.4.0 20160609 (Ubuntu 5.4.0-6ubuntu1~16.04.9)
+               gcc version 7.2.0 (Debian 7.2.0-19)
+ -----------------------------------------------------------------------------------
+*/
+#ifndef COMBINATION_SUMMARY_H
+#define COMBINATION_SUMMARY_H
+
+#include <vector>
+#include <string>
+#include <iostream>
+
+#include "magic_cube.h"
+#include "thread_pool.h"
+
+/**
+ * Resultats d'une combinaison de pieces
+ */
+struct CombinationSummary {
+    std::string pieces;             // noms des pieces, dans l'ordre de l'ArrPieces
+    size_t rawCount;                // solutions de bruteForceMagicCube
+    size_t distinctCount;           // sans permutation des pieces semblables
+    size_t symmetricCount;          // distinctes aussi a une rotation ou reflexion du cube pres
+    unsigned long long nodes;       // noeuds visites par la recherche
+    double seconds;
+};
+
+/**
+ * @brief Resume de chaque combinaison, calcule en parallele
+ *
+ * Chaque combinaison est resolue par HeuristicSearch (ordre dynamique et
+ * elagage par coloration), qui produit directement les solutions distinctes ;
+ * le nombre brut s'en deduit par les permutations des pieces semblables.
+ *
+ * @return un resume par combinaison, dans l'ordre de allCombinations
+ */
+std::vector<CombinationSummary> summarizeCombinations(ThreadPool& pool, const std::vector<ArrPieces>& allCombinations);
+
+/**
+ * @brief Controle d'une cle de tri, avant de lancer le calcul des resumes
+ *
+ * @return true si sortSummaries accepte la cle
+ */
+bool isSortKey(const std::string& key);
+
+/**
+ * @brief Tri stable des resumes
+ *
+ * @param[in] key pieces, raw, distinct, symmetric, nodes ou time, precede de '-'
+ *                pour un ordre decroissant
+ *
+ * @exception std::invalid_argument si la cle est inconnue
+ */
+void sortSummaries(std::vector<CombinationSummary>& summaries, const std::string& key);
+
+void writeCsv(std::ostream& os, const std::vector<CombinationSummary>& summaries);
+void writeJson(std::ostream& os, const std::vector<CombinationSummary>& summaries);
+
+#endif
@@ -0,0 +1,179 @@
+/*
+ -----------------------------------------------------------------------------------
+ Laboratoire : ASD1 Cube magique
+ Fichier     : fixed_solver.h
+ Auteur(s)   : Jorge-André Fulgencio Esteves <jorgeand.fulgencioesteves@heig-vd.ch>,
+               Florian Schaufelberger <florian.schaufelberger@heig-vd.ch>,
+               Jonathan Zaehringer <jonathan.zaehringer@heig-vd.ch>
+
+ Date        : 27.03.2018
+
+ Compilateur : Apple LLVM version 9.0.0 (clang-900.0.39.2)
+               gcc version 5.4.0 20160609 (Ubuntu 5.4.0-6ubuntu1~16.04.9)
+               gcc version 7.2.0 (Debian 7.2.0-19)
+ -----------------------------------------------------------------------------------
+*/
+#ifndef FIXED_SOLVER_H
+#define FIXED_SOLVER_H
+
+#include <cstddef>
+#include <cstdint>
+#include <array>
+#include <type_traits>
+
+#include "base_shapes.h"
+#include "puzzle.h"
+
+typedef uint_fast64_t FixedMask;
+
+/**
+ * Dimensions du plateau connues a la compilation.
+ *
+ * L'indice d'une case est x + X * y + X * Y * z, ce qui correspond a
+ * toFastPiece pour le cube 3x3x3.
+ */
+template <int X, int Y, int Z>
+struct Board {
+    static constexpr int SIZE_X = X;
+    static constexpr int SIZE_Y = Y;
+    static constexpr int SIZE_Z = Z;
+    static constexpr int NB_CELLS = X * Y * Z;
+
+    static_assert(NB_CELLS <= 64, "Le plateau doit tenir dans un masque de 64 bits");
+};
+
+/**
+ * Table des masques de toutes les translations d'une piece sur un plateau
+ */
+template <std::size_t N>
+struct PlacementTable {
+    FixedMask masks[N == 0 ? 1 : N];
+};
+
+namespace fixed_detail {
+    template <typename Kind>
+    constexpr std::size_t nbShapes() {
+        return std::extent<decltype(Kind::SHAPES), 0>::value;
+    }
+
+    template <typename Kind>
+    constexpr std::size_t nbCubes() {
+        return std::extent<decltype(Kind::SHAPES), 1>::value;
+    }
+
+    template <typename B, typename Kind>
+    constexpr bool fits(std::size_t s, int x, int y, int z) {
+        for(std::size_t c = 0; c < nbCubes<Kind>(); c++) {
+            if(Kind::SHAPES[s][c][0] + x >= B::SIZE_X ||
+               Kind::SHAPES[s][c][1] + y >= B::SIZE_Y ||
+               Kind::SHAPES[s][c][2] + z >= B::SIZE_Z) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    template <typename B, typename Kind>
+    constexpr FixedMask mask(std::size_t s, int x, int y, int z) {
+        FixedMask m = 0;
+        for(std::size_t c = 0; c < nbCubes<Kind>(); c++) {
+            m |= FixedMask(1) << (Kind::SHAPES[s][c][0] + x
+                                + B::SIZE_X * (Kind::SHAPES[s][c][1] + y)
+                                + B::SIZE_X * B::SIZE_Y * (Kind::SHAPES[s][c][2] + z));
+        }
+        return m;
+    }
+
+    template <typename B, typename Kind>
+    constexpr std::size_t countPlacements() {
+        std::size_t n = 0;
+        for(int x = 0; x < B::SIZE_X; x++) {
+            for(int y = 0; y < B::SIZE_Y; y++) {
+                for(int z = 0; z < B::SIZE_Z; z++) {
+                    for(std::size_t s = 0; s < nbShapes<Kind>(); s++) {
+                        n += fits<B, Kind>(s, x, y, z) ? 1 : 0;
+                    }
+                }
+            }
+        }
+        return n;
+    }
+
+    template <typename B, typename Kind, std::size_t N>
+    constexpr PlacementTable<N> buildPlacements() {
+        PlacementTable<N> table{};
+        std::size_t n = 0;
+        for(int x = 0; x < B::SIZE_X; x++) {
+            for(int y = 0; y < B::SIZE_Y; y++) {
+                for(int z = 0; z < B::SIZE_Z; z++) {
+                    for(std::size_t s = 0; s < nbShapes<Kind>(); s++) {
+                        if(fits<B, Kind>(s, x, y, z)) {
+                            table.masks[n++] = mask<B, Kind>(s, x, y, z);
+                        }
+                    }
+                }
+            }
+        }
+        return table;
+    }
+}
+
+/**
+ * Placements d'un type de piece (CBase, LBase, ...) sur un plateau, calcules
+ * a la compilation dans le meme ordre que Piece::generateAllPositions.
+ */
+template <typename B, typename Kind>
+struct Placements {
+    static constexpr std::size_t SIZE = fixed_detail::countPlacements<B, Kind>();
+    static constexpr PlacementTable<SIZE> TABLE = fixed_detail::buildPlacements<B, Kind, SIZE>();
+};
+
+template <typename B, typename Kind>
+constexpr std::size_t Placements<B, Kind>::SIZE;
+
+template <typename B, typename Kind>
+constexpr PlacementTable<Placements<B, Kind>::SIZE> Placements<B, Kind>::TABLE;
+
+/**
+ * Solveur dont les types de pieces et le plateau sont fixes a la compilation.
+ *
+ * La recursion est deroulee par profondeur (une instanciation par niveau),
+ * ce qui permet au compilateur de garder le masque d'occupation en registre
+ * et de specialiser chaque niveau sur la table de placements de sa piece.
+ *
+ * Les pieces sont posees dans l'ordre des parametres Kinds : pour retrouver
+ * l'ordre de bruteForceMagicCube, il faut donc les lister de la derniere a la
+ * premiere piece de l'ArrPieces equivalent.
+ */
+template <typename B, typename... Kinds>
+class FixedSolver {
+public :
+    static constexpr std::size_t DEPTH = sizeof...(Kinds);
+    typedef std::array<FixedMask, DEPTH> Solution;
+
+    /**
+     * @brief Enumere toutes les solutions
+     *
+     * @param[in] visitor appele avec chaque Solution trouvee
+     * @param[in] blocked cases deja occupees avant la pose des pieces
+     */
+    template <typename Visitor>
+    static void solve(Visitor& visitor, FixedMask blocked = 0);
+
+    /**
+     * @brief Compte les solutions sans les stocker
+     */
+    static std::size_t count(FixedMask blocked = 0);
+
+    /**
+     * @brief Conversion d'une solution en Puzzle (plateaux de 32 cases au plus)
+     *
+     * @param[in] solution masques des pieces posees
+     * @param[in] ids      identifiant de chaque piece, dans l'ordre de Kinds
+     */
+    static Puzzle toPuzzle(const Solution& solution, const unsigned (&ids)[DEPTH]);
+};
+
+#include "fixed_solver_impl.h"
+
+#endif
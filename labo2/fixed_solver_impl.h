@@ -0,0 +1,79 @@
+#ifndef FIXED_SOLVER_IMPL_H
+#define FIXED_SOLVER_IMPL_H
+
+#include "fixed_solver.h"
+
+namespace fixed_detail {
+    /**
+     * Niveau D de la recursion : pose la piece Kind puis delegue au niveau
+     * suivant. Chaque niveau est un type distinct, la recursion est donc
+     * entierement deroulee a la compilation.
+     */
+    template <typename B, std::size_t D, typename... Kinds>
+    struct Level;
+
+    template <typename B, std::size_t D, typename Kind, typename... Rest>
+    struct Level<B, D, Kind, Rest...> {
+        template <typename Solution, typename Visitor>
+        static void run(FixedMask cube, Solution& placed, Visitor& visitor) {
+            for(std::size_t i = 0; i < Placements<B, Kind>::SIZE; i++) {
+                const FixedMask m = Placements<B, Kind>::TABLE.masks[i];
+                if((cube & m) == 0) {
+                    placed[D] = m;
+                    Level<B, D + 1, Rest...>::run(cube | m, placed, visitor);
+                }
+            }
+        }
+    };
+
+    template <typename B, std::size_t D>
+    struct Level<B, D> {
+        template <typename Solution, typename Visitor>
+        static void run(FixedMask, Solution& placed, Visitor& visitor) {
+            visitor(static_cast<const Solution&>(placed));
+        }
+    };
+
+    struct Counter {
+        std::size_t count;
+
+        template <typename Solution>
+        void operator () (const Solution&) {
+            ++count;
+        }
+    };
+}
+
+template <typename B, typename... Kinds>
+template <typename Visitor>
+void FixedSolver<B, Kinds...>::solve(Visitor& visitor, FixedMask blocked) {
+    Solution placed{};
+    fixed_detail::Level<B, 0, Kinds...>::run(blocked, placed, visitor);
+}
+
+template <typename B, typename... Kinds>
+std::size_t FixedSolver<B, Kinds...>::count(FixedMask blocked) {
+    fixed_detail::Counter counter{0};
+    solve(counter, blocked);
+    return counter.count;
+}
+
+template <typename B, typename... Kinds>
+Puzzle FixedSolver<B, Kinds...>::toPuzzle(const Solution& solution, const unsigned (&ids)[DEPTH]) {
+    static_assert(B::NB_CELLS <= 32, "Un Puzzle ne represente que des plateaux de 32 cases au plus");
+    static const char NAMES[] = {Kinds::NAME...};
+
+    Puzzle puzzle;
+    for(std::size_t d = 0; d < DEPTH; d++) {
+        Shape shape;
+        for(int i = 0; i < B::NB_CELLS; i++) {
+            if(solution[d] & (FixedMask(1) << i)) {
+                shape.push_back(Point{i % B::SIZE_X, (i / B::SIZE_X) % B::SIZE_Y, i / (B::SIZE_X * B::SIZE_Y)});
+            }
+        }
+        puzzle.tryToInsert(Piece(shape, uint_fast32_t(solution[d]), ids[d], NAMES[d]));
+    }
+    return puzzle;
+}
+
+#endif //FIXED_SOLVER_IMPL_H
@@ -0,0 +1,233 @@
+/*
+ -----------------------------------------------------------------------------------
+ Laboratoire : ASD1 Cube magique
+ Fichier     : heuristic_search.cpp
+ Auteur(s)   : Jorge-André Fulgencio Esteves <jorgeand.fulgencioesteves@heig-vd.ch>,
+               Florian Schaufelberger <florian.schaufelberger@heig-vd.ch>,
+               Jonathan Zaehringer <jonathan.zaehringer@heig-vd.ch>
+
+ Date        : 27.03.2018
+
+ Compilateur : Apple LLVM version 9.0.0 (clang-900.0.39.2)
+               gcc version 5.4.0 20160609 (Ubuntu 5.4.0-6ubuntu1~16.04.9)
+               gcc version 7.2.0 (Debian 7.2.0-19)
+ -----------------------------------------------------------------------------------
+*/
+#include <algorithm>
+
+#include "heuristic_search.h"
+
+namespace {
+    const uint_fast32_t CUBE = (uint_fast32_t(1) << 27) - 1;
+
+    // Cases (x, y, z) avec x + y + z pair, indice x + 3y + 9z
+    uint_fast32_t evenCells() {
+        uint_fast32_t mask = 0;
+        for(int cell = 0; cell < 27; cell++) {
+            if((cell % 3 + cell / 3 % 3 + cell / 9) % 2 == 0) {
+                mask |= uint_fast32_t(1) << cell;
+            }
+        }
+        return mask;
+    }
+
+    const uint_fast32_t EVEN = evenCells();
+}
+
+HeuristicSearch::HeuristicSearch(const ArrPieces& allPieces, Options options)
+    : options(options), nbPieces(allPieces.size()),
+      tracked(options.mostConstrained || options.colourPruning), nbNodes(0) {
+    for(size_t i = allPieces.size(); i-- > 0;) {
+        const Pieces& pieces = allPieces[i];
+        if(pieces.empty()) {
+            continue;
+        }
+
+        auto same = [&pieces](const Type& t) { return t.copies.front()->front().getName() == pieces.front().getName(); };
+        auto it = std::find_if(types.begin(), types.end(), same);
+        if(it != types.end()) {
+            it->copies.push_back(&pieces);
+            it->remaining++;
+            continue;
+        }
+
+        Type type;
+        type.copies.push_back(&pieces);
+        type.nbWords = (pieces.size() + 63) / 64;
+        type.byCell.assign(27 * type.nbWords, 0);
+        type.available.assign(type.nbWords, 0);
+        type.byColour.assign(size_t(__builtin_popcount(uint32_t(pieces.front().getMask()))) + 1,
+                             std::vector<uint64_t>(type.nbWords, 0));
+        for(size_t p = 0; p < pieces.size(); p++) {
+            const uint64_t bit = uint64_t(1) << (p % 64);
+            type.masks.push_back(pieces[p].getMask());
+            type.available[p / 64] |= bit;
+            type.byColour[size_t(__builtin_popcount(uint32_t(pieces[p].getMask() & EVEN)))][p / 64] |= bit;
+            for(size_t cell = 0; cell < 27; cell++) {
+                if(pieces[p].getMask() & (uint_fast32_t(1) << cell)) {
+                    type.byCell[cell * type.nbWords + p / 64] |= bit;
+                }
+            }
+        }
+        type.saved.resize(nbPieces * type.nbWords);
+        type.remaining = 1;
+        type.next = 0;
+        types.push_back(type);
+    }
+}
+
+void HeuristicSearch::solve(Puzzles& solutions) {
+    Puzzle puzzle;
+    size_t n = 0;
+    nbNodes = 0;
+    search(0, 0, puzzle, &solutions, n);
+}
+
+size_t HeuristicSearch::count() {
+    Puzzle puzzle;
+    size_t n = 0;
+    nbNodes = 0;
+    search(0, 0, puzzle, nullptr, n);
+    return n;
+}
+
+unsigned long long HeuristicSearch::nodes() const {
+    return nbNodes;
+}
+
+size_t HeuristicSearch::chooseType() const {
+    size_t best = types.size();
+    size_t bestFree = 0;
+    for(size_t t = 0; t < types.size(); t++) {
+        if(types[t].remaining == 0) {
+            continue;
+        }
+        if(!options.mostConstrained) {
+            return t;
+        }
+        const size_t n = nbFree(types[t]);
+        if(best == types.size() || n < bestFree) {
+            best = t;
+            bestFree = n;
+        }
+    }
+    return best;
+}
+
+size_t HeuristicSearch::nbFree(const Type& type) {
+    size_t n = 0;
+    for(uint64_t word : type.available) {
+        n += size_t(__builtin_popcountll(word));
+    }
+    return n;
+}
+
+bool HeuristicSearch::colourFeasible(uint_fast32_t cube) const {
+    // reachable : bit k pose si les pieces deja considerees peuvent couvrir k cases paires
+    uint64_t reachable = 1;
+    for(const Type& type : types) {
+        uint64_t colours = 0;
+        for(size_t k = 0; k < type.byColour.size(); k++) {
+            for(size_t w = 0; w < type.nbWords; w++) {
+                if(type.available[w] & type.byColour[k][w]) {
+                    colours |= uint64_t(1) << k;
+                    break;
+                }
+            }
+        }
+
+        for(size_t copy = 0; copy < type.remaining; copy++) {
+            uint64_t next = 0;
+            for(uint64_t c = colours; c != 0; c &= c - 1) {
+                next |= reachable << __builtin_ctzll(c);
+            }
+            reachable = next;
+        }
+    }
+
+    const int emptyEven = __builtin_popcount(uint32_t(~cube & CUBE & EVEN));
+    return (reachable >> emptyEven) & 1;
+}
+
+void HeuristicSearch::place(size_t depth, uint_fast32_t mask) {
+    for(Type& type : types) {
+        std::copy(type.available.begin(), type.available.end(), type.saved.begin() + long(depth * type.nbWords));
+        for(uint_fast32_t m = mask; m != 0; m &= m - 1) {
+            const uint64_t* covering = &type.byCell[size_t(__builtin_ctz(uint32_t(m))) * type.nbWords];
+            for(size_t w = 0; w < type.nbWords; w++) {
+                type.available[w] &= ~covering[w];
+            }
+        }
+    }
+}
+
+void HeuristicSearch::unplace(size_t depth) {
+    for(Type& type : types) {
+        const auto first = type.saved.begin() + long(depth * type.nbWords);
+        std::copy(first, first + long(type.nbWords), type.available.begin());
+    }
+}
+
+void HeuristicSearch::search(uint_fast32_t cube, size_t placed, Puzzle& puzzle, Puzzles* solutions, size_t& count) {
+    ++nbNodes;
+
+    if(placed == nbPieces) {
+        ++count;
+        if(solutions) {
+            solutions->push_back(puzzle);
+        }
+        return;
+    }
+
+    if(options.mostConstrained) {
+        for(const Type& type : types) {
+            if(type.remaining != 0 && nbFree(type) < type.remaining) {
+                return;
+            }
+        }
+    }
+
+    if(options.colourPruning && !colourFeasible(cube)) {
+        return;
+    }
+
+    Type& type = types[chooseType()];
+    const Pieces& copy = *type.copies[type.copies.size() - type.remaining];
+    const size_t next = type.next;
+
+    type.remaining--;
+    for(size_t w = next / 64; w < type.nbWords; w++) {
+        // Si available n'est pas tenu a jour : les conflits sont testes sur le cube
+        uint64_t bits = type.available[w];
+        if(w == next / 64) {
+            bits &= ~uint64_t(0) << (next % 64);
+        }
+
+        for(; bits != 0; bits &= bits - 1) {
+            const size_t i = w * 64 + size_t(__builtin_ctzll(bits));
+            const uint_fast32_t mask = type.masks[i];
+            if(cube & mask) {
+                continue;
+            }
+
+            if(tracked) {
+                place(placed, mask);
+            }
+            type.next = i + 1;
+            if(solutions) {
+                puzzle.tryToInsert(copy[i]);
+            }
+
+            search(cube | mask, placed + 1, puzzle, solutions, count);
+
+            if(solutions) {
+                puzzle.popLastPiece();
+            }
+            if(tracked) {
+                unplace(placed);
+            }
+        }
+    }
+    type.remaining++;
+    type.next = next;
+}
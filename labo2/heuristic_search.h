@@ -0,0 +1,98 @@
+/*
+ -----------------------------------------------------------------------------------
+ Laboratoire : ASD1 Cube magique
+ Fichier     : heuristic_search.h
+ Auteur(s)   : Jorge-André Fulgencio Esteves <jorgeand.fulgencioesteves@heig-vd.ch>,
+               Florian Schaufelberger <florian.schaufelberger@heig-vd.ch>,
+               Jonathan Zaehringer <jonathan.zaehringer@heig-vd.ch>
+
+ Date        : 27.03.2018
+
+ Compilateur : Apple LLVM version 9.0.0 (clang-900.0.39.2)
+               gcc version 5.4.0 20160609 (Ubuntu 5.4.0-6ubuntu1~16.04.9)
+               gcc version 7.2.0 (Debian 7.2.0-19)
+ -----------------------------------------------------------------------------------
+*/
+#ifndef HEURISTIC_SEARCH_H
+#define HEURISTIC_SEARCH_H
+
+#include <vector>
+#include <cstdint>
+
+#include "magic_cube.h"
+
+/**
+ * Recherche par masques sur les types de pieces d'une ArrPieces.
+ *
+ * Les copies d'un meme type sont interchangeables : elles sont posees dans
+ * l'ordre croissant de leurs placements, chaque solution n'est donc produite
+ * qu'une fois (le resultat correspond a removeSolutionByPermutation).
+ *
+ * En mode mostConstrained, chaque noeud branche sur le type ayant le moins
+ * de placements encore libres et abandonne des qu'un type n'a plus assez de
+ * placements pour ses copies. Les placements libres de chaque type sont
+ * gardes sous forme de bits : une pose retire ceux couvrant ses cases (quelques
+ * mots par case) et les compteurs s'obtiennent par popcount, sans jamais
+ * retester tous les placements contre le cube.
+ *
+ * Avec colourPruning, les cases sont colorees en damier (x + y + z pair ou
+ * impair) et chaque placement connait son nombre de cases paires. Un noeud est
+ * abandonne si aucune combinaison des placements encore libres des pieces
+ * restantes ne couvre exactement les cases paires vides.
+ */
+class HeuristicSearch {
+public :
+    struct Options {
+        bool mostConstrained;
+        bool colourPruning;
+    };
+
+private :
+    struct Type {
+        std::vector<const Pieces*> copies;            // une liste de placements par copie
+        std::vector<uint_fast32_t> masks;             // placements communs aux copies
+        size_t nbWords;                               // mots de 64 bits par ensemble de placements
+        std::vector<uint64_t> byCell;                 // placements couvrant chaque case (27 ensembles)
+        std::vector<uint64_t> available;              // placements compatibles avec le cube
+        std::vector<std::vector<uint64_t>> byColour;  // placements par nombre de cases paires couvertes
+        std::vector<uint64_t> saved;                  // available avant chaque pose, par profondeur
+        size_t remaining;                             // copies restant a poser
+        size_t next;                                  // premier placement autorise pour la copie suivante
+    };
+
+    std::vector<Type> types;   // dans l'ordre de pose de bruteForceMagicCube
+    Options options;
+    size_t nbPieces;
+    bool tracked;                                     // available tenu a jour a chaque pose
+    unsigned long long nbNodes;
+
+    void search(uint_fast32_t cube, size_t placed, Puzzle& puzzle, Puzzles* solutions, size_t& count);
+    size_t chooseType() const;
+    static size_t nbFree(const Type& type);
+    bool colourFeasible(uint_fast32_t cube) const;
+    void place(size_t depth, uint_fast32_t mask);
+    void unplace(size_t depth);
+
+public :
+    /**
+     * @param[in] allPieces placements de chaque piece, comme pour bruteForceMagicCube
+     */
+    HeuristicSearch(const ArrPieces& allPieces, Options options);
+
+    /**
+     * @brief Ajoute chaque solution (sans permutation des pieces semblables)
+     */
+    void solve(Puzzles& solutions);
+
+    /**
+     * @brief Nombre de solutions, sans construire les Puzzle
+     */
+    size_t count();
+
+    /**
+     * @brief Noeuds visites par le dernier appel a solve ou count
+     */
+    unsigned long long nodes() const;
+};
+
+#endif
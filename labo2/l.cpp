@@ -16,40 +16,11 @@
 #include <vector>
 
 #include "l.h"
+#include "base_shapes.h"
 
 using namespace std;
 
-Shapes L::POSITION_BASE = {
-    Shape{Point{0,0,0}, Point{1,0,0}, Point{2,0,0}, Point{0,1,0}},
-    Shape{Point{0,0,0}, Point{1,0,0}, Point{2,0,0}, Point{0,0,1}},
-    Shape{Point{0,0,0}, Point{0,1,0}, Point{1,1,0}, Point{2,1,0}},
-    Shape{Point{0,0,0}, Point{1,0,1}, Point{2,0,1}, Point{0,0,1}},
-
-    Shape{Point{0,0,0}, Point{1,0,0}, Point{0,1,0}, Point{0,2,0}},
-    Shape{Point{0,0,0}, Point{0,1,0}, Point{0,2,0}, Point{0,0,1}},
-    Shape{Point{0,0,0}, Point{1,0,0}, Point{1,1,0}, Point{1,2,0}},
-    Shape{Point{0,0,0}, Point{0,0,1}, Point{0,1,1}, Point{0,2,1}},
-
-    Shape{Point{0,0,0}, Point{0,1,0}, Point{0,2,0}, Point{1,2,0}},
-    Shape{Point{0,0,0}, Point{0,1,0}, Point{0,2,0}, Point{0,2,1}},
-    Shape{Point{0,2,0}, Point{1,2,0}, Point{1,1,0}, Point{1,0,0}},
-    Shape{Point{0,2,0}, Point{0,2,1}, Point{0,1,1}, Point{0,0,1}},
-
-    Shape{Point{0,0,0}, Point{0,1,0}, Point{0,1,1}, Point{0,1,2}},
-    Shape{Point{0,1,0}, Point{1,1,0}, Point{2,1,0}, Point{2,0,0}},
-    Shape{Point{0,0,0}, Point{1,0,0}, Point{2,0,0}, Point{2,1,0}},
-    Shape{Point{0,0,0}, Point{1,0,0}, Point{2,0,0}, Point{2,0,1}},
-
-    Shape{Point{0,0,0}, Point{0,0,1}, Point{0,0,2}, Point{1,0,2}},
-    Shape{Point{0,0,0}, Point{0,0,1}, Point{0,0,2}, Point{0,1,2}},
-    Shape{Point{1,0,0}, Point{1,0,1}, Point{1,0,2}, Point{0,0,2}},
-    Shape{Point{0,1,0}, Point{0,1,1}, Point{0,1,2}, Point{0,0,2}},
-
-    Shape{Point{0,0,1}, Point{1,0,1}, Point{2,0,1}, Point{2,0,0}},
-    Shape{Point{0,0,2}, Point{0,0,1}, Point{0,0,0}, Point{1,0,0}},
-    Shape{Point{0,1,0}, Point{0,0,0}, Point{0,0,1}, Point{0,0,2}},
-    Shape{Point{0,0,0}, Point{1,0,0}, Point{1,0,1}, Point{1,0,2}},
-};
+Shapes L::POSITION_BASE = toShapes(LBase::SHAPES);
 
 Shapes L::positions;
 vector<uint_fast32_t> L::fast_positions;
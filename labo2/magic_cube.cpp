@@ -17,9 +17,13 @@
 #include <iostream>
 #include <ctime>
 #include <string>
+#include <cstdio>
+#include <stdexcept>
+#include <algorithm>
 
 #include "magic_cube.h"
 #include "puzzle.h"
+#include "checkpoint.h"
 #include "c.h"
 #include "t.h"
 #include "l.h"
@@ -66,44 +70,103 @@ void recursion(std::vector<ArrPieces>& allCombinations, ArrPieces& allPieces, un
 }
 
 
-void megaBruteForce(ArrPieces& allPieces, Puzzles& solutions) {
+void generateCombinations(std::vector<ArrPieces>& allCombinations, ArrPieces& allPieces) {
+    recursion(allCombinations, allPieces, 0, 0, 0);
+}
+
+void appendCombinationSolutions(Puzzles& combinationSolutions, Puzzles& solutions) {
+    solutions.insert(solutions.end(), combinationSolutions.begin(), combinationSolutions.end());
+    solutions.push_back(Puzzle());
+}
+
+void megaBruteForce(ArrPieces& allPieces, Puzzles& solutions, const std::string& checkpointFile, long checkpointInterval) {
     std::vector<ArrPieces> allCombinations;
 	Pieces temp;
     ArrPieces minimalCombination;
     Puzzles   minimalSolution;
 
+    // La premiere combinaison ayant le moins de solutions (non nul) l'emporte
+    auto keepMinimal = [&](const ArrPieces& tab, Puzzles::const_iterator first, Puzzles::const_iterator last) {
+        const size_t count = size_t(last - first);
+        if(count != 0 && (minimalSolution.empty() || count < minimalSolution.size())) {
+            minimalCombination = tab;
+            minimalSolution.assign(first, last);
+        }
+    };
+
     std::cout << "Calcul des combinaisons des pieces T, L, S et C." << std::endl;
-	recursion(allCombinations, allPieces, 0, 0, 0);
+	generateCombinations(allCombinations, allPieces);
 	
     std::cout << allCombinations.size() << " combinasions valables ont ete trouve." << std::endl << std::endl;
+
+    Checkpoint checkpoint{0, allCombinations.size(), {}, {}, {}};
+    if(!checkpointFile.empty() && loadCheckpoint(checkpointFile, checkpoint)) {
+        if(checkpoint.nbCombinations != allCombinations.size() || checkpoint.combination > allCombinations.size()) {
+            throw std::runtime_error("megaBruteForce : le point de reprise ne correspond pas a ces combinaisons");
+        }
+        solutions = checkpoint.solutions;
+
+        // Les combinaisons terminees sont separees par un Puzzle vide : la combinaison
+        // minimale se retrouve sans l'enregistrer dans le point de reprise
+        size_t c = 0;
+        for(auto first = solutions.cbegin(); first != solutions.cend(); ++c) {
+            auto last = std::find_if(first, solutions.cend(), [](const Puzzle& p) { return p.getPieces().empty(); });
+            if(last == solutions.cend() || c >= checkpoint.combination) {
+                throw std::runtime_error("megaBruteForce : le point de reprise est incoherent");
+            }
+            keepMinimal(allCombinations[c], first, last);
+            first = last + 1;
+        }
+        if(c != checkpoint.combination) {
+            throw std::runtime_error("megaBruteForce : le point de reprise est incoherent");
+        }
+        std::cout << "Reprise a la combinaison " << checkpoint.combination + 1 << " depuis " << checkpointFile << std::endl;
+    }
+    auto lastSave = time(nullptr);
 	
-    for(ArrPieces tab : allCombinations) {
+    for(size_t c = checkpoint.combination; c < allCombinations.size(); ++c) {
+        const ArrPieces& tab = allCombinations[c];
         Puzzles tempSolutions;
+        std::vector<size_t> stack;
+
+        if(c == checkpoint.combination) {
+            stack = checkpoint.stack;
+            tempSolutions = checkpoint.current;
+        }
 
         std::cout << "Cette combinaison : ";
-        for(Pieces p : tab) {
+        for(const Pieces& p : tab) {
             std::cout << p.at(0).getName() << " ";
         }
         std::cout << std::endl;
 
-        bruteForceMagicCube(tab, tempSolutions);
+        auto save = [&]() {
+            if(checkpointFile.empty() || time(nullptr) - lastSave < checkpointInterval) {
+                return;
+            }
+            saveCheckpoint(checkpointFile, Checkpoint{c, allCombinations.size(), stack, tempSolutions, solutions});
+            lastSave = time(nullptr);
+        };
+
+        std::cout << "\rEn cours de Brute force (trouver : " << tempSolutions.size() << ")... ";
+        auto now = time(nullptr);
+        resumableBruteForce(tab, tempSolutions, stack, save);
+        std::cout << "Fini en " << time(nullptr) - now << "[s]" << std::endl;
+
 		removeSolutionByPermutation(tempSolutions);
 
         std::cout << std::endl;
 
-        if(tempSolutions.size() != 0) {
-            if(tempSolutions.size() < minimalSolution.size()) {
-                minimalCombination = tab;
-                minimalSolution = tempSolutions;
-            }
-
-            solutions.insert(solutions.end(), tempSolutions.begin(), tempSolutions.end());
-        }
+        keepMinimal(tab, tempSolutions.cbegin(), tempSolutions.cend());
 
-        solutions.push_back(Puzzle());
+        appendCombinationSolutions(tempSolutions, solutions);
         tempSolutions.clear();
     }
 
+    if(!checkpointFile.empty()) {
+        remove(checkpointFile.c_str());
+    }
+
     std::cout << "Combinaison ayant le moin de solution est ";
     for(Pieces p : minimalCombination) {
         std::cout << p.at(0).getName() << " ";
@@ -143,6 +206,53 @@ void bruteForceMagicCube(const ArrPieces& allPieces, Puzzles& solutions, Puzzle&
     }
 }
 
+void resumableBruteForce(const ArrPieces& allPieces, Puzzles& solutions, std::vector<size_t>& stack,
+                         const std::function<void()>& onCheckpoint, unsigned long period) {
+    const size_t depth = allPieces.size();
+    Puzzle puzzle;
+
+    if(stack.empty()) {
+        stack.push_back(0);
+    }
+
+    // Reconstruction du puzzle a partir des placements deja poses
+    for(size_t d = 0; d + 1 < stack.size(); d++) {
+        puzzle.tryToInsert(allPieces.at(depth - 1 - d).at(stack[d]));
+    }
+
+    for(unsigned long countdown = period; !stack.empty();) {
+        if(--countdown == 0) {
+            onCheckpoint();
+            countdown = period;
+        }
+
+        const Pieces& candidates = allPieces[depth - stack.size()];
+        const size_t nbCandidates = candidates.size();
+        size_t i = stack.back();
+
+        // Avance jusqu'au prochain placement libre sans repasser par la boucle principale
+        while(i < nbCandidates && !puzzle.tryToInsert(candidates[i])) {
+            ++i;
+        }
+
+        if(i >= nbCandidates) {
+            stack.pop_back();
+            if(!stack.empty()) {
+                puzzle.popLastPiece();
+                ++stack.back();
+            }
+        } else if(stack.size() == depth) {
+            solutions.push_back(puzzle);
+            std::cout << std::flush << "\rEn cours de Brute force (trouver : " << solutions.size() << ")... ";
+            puzzle.popLastPiece();
+            stack.back() = i + 1;
+        } else {
+            stack.back() = i;
+            stack.push_back(0);
+        }
+    }
+}
+
 void removeSolutionByPermutation(Puzzles& solutions) {
 	if(solutions.size() < 2) {
 		return;
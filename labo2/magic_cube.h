@@ -18,16 +18,32 @@
 
 #include <vector>
 #include <iostream>
+#include <string>
+#include <functional>
 
 #include "puzzle.h"
 
 typedef std::vector<Pieces> ArrPieces;
 
-void megaBruteForce(ArrPieces& allPieces, Puzzles& solutions);
+//Si checkpointFile est donne, l'etat est sauve toutes les checkpointInterval secondes
+//et la recherche reprend depuis ce fichier s'il existe
+void megaBruteForce(ArrPieces& allPieces, Puzzles& solutions,
+                    const std::string& checkpointFile = "", long checkpointInterval = 60);
 void bruteForceMagicCube(const ArrPieces& allPieces, Puzzles& solutions);
+//Enumere, dans un ordre deterministe, les combinaisons de pieces remplissant le cube
+void generateCombinations(std::vector<ArrPieces>& allCombinations, ArrPieces& allPieces);
+//Ajoute les solutions d'une combinaison terminee (sans doublons) suivies d'un separateur
+void appendCombinationSolutions(Puzzles& combinationSolutions, Puzzles& solutions);
 //Decorator of recursive function
 void bruteForceMagicCube(const ArrPieces& allPieces, Puzzles& solutions, Puzzle& puzzle, size_t index = 0);
 
+//Version iterative de bruteForceMagicCube pouvant etre interrompue puis reprise.
+//stack contient l'indice du placement de chaque piece posee suivi du prochain
+//placement a essayer ; onCheckpoint est appele toutes les period iterations,
+//a un moment ou stack et solutions decrivent exactement l'etat de la recherche.
+void resumableBruteForce(const ArrPieces& allPieces, Puzzles& solutions, std::vector<size_t>& stack,
+                         const std::function<void()>& onCheckpoint, unsigned long period = 1ul << 16);
+
 void removeSolutionByPermutation(Puzzles& solutions);
 
 int countSolutionMatching(Piece& piece, Puzzles& solutions);
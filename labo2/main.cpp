@@ -15,6 +15,11 @@
 */
 #include <cstdlib>
 #include <vector>
+#include <ctime>
+#include <string>
+#include <sstream>
+#include <random>
+#include <chrono>
 
 #include "c.h"
 #include "t.h"
@@ -22,11 +27,310 @@
 #include "s.h"
 #include "puzzle.h"
 #include "magic_cube.h"
+#include "fixed_solver.h"
+#include "shard.h"
+#include "solver_context.h"
+#include "result_cache.h"
+#include "solution_diagram.h"
+#include "solution_writer.h"
+#include "heuristic_search.h"
+#include "piece_library.h"
+#include "restart_search.h"
+#include "solution_sampler.h"
+#include "solution_index.h"
+#include "combination_summary.h"
 
 using namespace std;
 
+// Jeu standard LLLLTSC, pieces listees dans l'ordre de pose de bruteForceMagicCube
+typedef FixedSolver<Board<3, 3, 3>, CBase, SBase, TBase, LBase, LBase, LBase, LBase> StandardSolver;
 
-int main () {
+int main (int argc, char* argv[]) {
+
+    // Options : --checkpoint <fichier> [--checkpoint-interval <secondes>]
+    //           --shard <i>/<N> [--output <fichier>] : ne calcule que le shard i des combinaisons
+    //           --merge <fichier>... : fusionne les N shards dans allCombinaisons.txt
+    //           --batch <fichier> [--cache <fichier>] : compte les solutions de chaque instance
+    //                                                  "<pieces> [cases occupees]"
+    //           --summary <fichier.csv|fichier.json> [--sort <cle>] : resume de chaque combinaison
+    //                         (cle : pieces, raw, distinct, symmetric, nodes ou time, '-' pour decroitre)
+    //           --heuristic : compare, pour chaque combinaison, l'ordre fixe et l'ordre dynamique
+    //                         (piece la plus contrainte d'abord), puis avec l'elagage par coloration
+    //           --diagram <fichier> [--pieces <pieces>] : construit et sauve le diagramme (ZDD)
+    //                                                    des solutions, LLLLTSC par defaut
+    //           --compile <description> [--output <fichier>] : compile une bibliotheque de pieces
+    //           --library <fichier> [--pieces <pieces>] : resout le jeu de pieces avec une bibliotheque compilee
+    //           --first <workers> [--budget <noeuds>] [--max-nodes <noeuds>] [--pieces <pieces>] :
+    //                         cherche une seule solution par essais aleatoires avec redemarrages
+    //                         (--max-nodes : abandon au-dela de ce total, 0 pour ne jamais abandonner)
+    //           --sample <n> [--pieces <pieces>] : tire n solutions uniformement, sans les enumerer
+    //           --index <fichier> [--pieces <pieces>] : construit l'index des solutions pour --query
+    //           --query <fichier> [--socket <chemin>] : repond aux requetes (help) sur l'entree
+    //                                                  standard ou sur un socket Unix
+    string checkpointFile;
+    long checkpointInterval = 60;
+    size_t shard = 0, nbShards = 0;
+    string outputFile;
+    vector<string> mergeFiles;
+    string batchFile;
+    string cacheFile;
+    string diagramFile;
+    string descriptionFile;
+    string libraryFile;
+    unsigned nbWorkers = 0;
+    unsigned long long budget = 1000;
+    unsigned long long maxNodes = 0;
+    unsigned long long nbSamples = 0;
+    string indexFile;
+    string queryFile;
+    string socketPath;
+    string summaryFile;
+    string sortKey = "pieces";
+    string pieceNames = "LLLLTSC";
+    bool heuristic = false;
+    for(int i = 1; i < argc; i++) {
+        string option(argv[i]);
+        if(option == "--merge") {
+            mergeFiles.assign(argv + i + 1, argv + argc);
+            break;
+        }
+        if(option == "--heuristic") {
+            heuristic = true;
+            continue;
+        }
+        if(i + 1 >= argc) {
+            break;
+        }
+        if(option == "--checkpoint") {
+            checkpointFile = argv[++i];
+        } else if(option == "--checkpoint-interval") {
+            checkpointInterval = atol(argv[++i]);
+        } else if(option == "--shard") {
+            // i/N, deux entiers decimaux avec 0 <= i < N
+            istringstream value(argv[++i]);
+            char slash = 0;
+            if(!(value >> shard >> slash >> nbShards) || slash != '/' || value.peek() != EOF
+               || string(argv[i]).find_first_not_of("0123456789/") != string::npos || shard >= nbShards) {
+                cerr << "Usage : --shard <i>/<N> avec 0 <= i < N (recu \"" << argv[i] << "\")" << endl;
+                return EXIT_FAILURE;
+            }
+        } else if(option == "--output") {
+            outputFile = argv[++i];
+        } else if(option == "--batch") {
+            batchFile = argv[++i];
+        } else if(option == "--cache") {
+            cacheFile = argv[++i];
+        } else if(option == "--diagram") {
+            diagramFile = argv[++i];
+        } else if(option == "--compile") {
+            descriptionFile = argv[++i];
+        } else if(option == "--library") {
+            libraryFile = argv[++i];
+        } else if(option == "--first") {
+            nbWorkers = unsigned(atol(argv[++i]));
+        } else if(option == "--budget") {
+            budget = strtoull(argv[++i], nullptr, 10);
+            if(budget == 0) {
+                cerr << "Usage : --budget <noeuds> avec un nombre de noeuds positif" << endl;
+                return EXIT_FAILURE;
+            }
+        } else if(option == "--max-nodes") {
+            maxNodes = strtoull(argv[++i], nullptr, 10);
+        } else if(option == "--sample") {
+            nbSamples = strtoull(argv[++i], nullptr, 10);
+        } else if(option == "--index") {
+            indexFile = argv[++i];
+        } else if(option == "--query") {
+            queryFile = argv[++i];
+        } else if(option == "--socket") {
+            socketPath = argv[++i];
+        } else if(option == "--summary") {
+            summaryFile = argv[++i];
+        } else if(option == "--sort") {
+            sortKey = argv[++i];
+            if(!isSortKey(sortKey)) {
+                cerr << "Usage : --sort <cle> avec pieces, raw, distinct, symmetric, nodes ou time,"
+                     << " precede de '-' pour decroitre (recu \"" << sortKey << "\")" << endl;
+                return EXIT_FAILURE;
+            }
+        } else if(option == "--pieces") {
+            pieceNames = argv[++i];
+        }
+    }
+
+    // Lot d'instances independantes, resolues en parallele
+    if(!batchFile.empty()) {
+        ifstream input(batchFile);
+        if(!input) {
+            cerr << "Lot : impossible de lire " << batchFile << endl;
+            return EXIT_FAILURE;
+        }
+
+        vector<Instance> instances;
+        size_t lineNumber = 0;
+        for(string line; getline(input, line);) {
+            ++lineNumber;
+            istringstream fields(line);
+            string names, blocked = "0";
+            if(fields >> names) {
+                fields >> blocked;
+                try {
+                    size_t end = 0;
+                    const unsigned long mask = stoul(blocked, &end, 0);
+                    if(end != blocked.size()) {
+                        throw invalid_argument(blocked);
+                    }
+                    instances.push_back(Instance{names, uint_fast32_t(mask)});
+                } catch(const logic_error&) {
+                    cerr << batchFile << ":" << lineNumber << " : cases occupees invalides \"" << blocked << "\"" << endl;
+                    return EXIT_FAILURE;
+                }
+            }
+        }
+
+        ThreadPool pool;
+        ResultCache cache;
+        vector<InstanceResult> results;
+        try {
+            if(!cacheFile.empty()) {
+                cache.load(cacheFile);
+            }
+            results = solveBatch(pool, instances, &cache);
+            if(!cacheFile.empty()) {
+                cache.save(cacheFile);
+            }
+        } catch(const exception& e) {
+            cerr << e.what() << endl;
+            return EXIT_FAILURE;
+        }
+        for(size_t i = 0; i < results.size(); i++) {
+            cout << instances[i].pieceNames << " " << instances[i].blocked << " : ";
+            if(results[i].error.empty()) {
+                cout << results[i].count << endl;
+            } else {
+                cout << results[i].error << endl;
+            }
+        }
+        cout << "Cache : " << cache.hits() << " instances deja connues, " << cache.misses() << " recherches" << endl;
+        return EXIT_SUCCESS;
+    }
+
+    // Bibliotheque de pieces compilee une fois pour toutes
+    if(!descriptionFile.empty()) {
+        try {
+            PieceLibrary::compile(descriptionFile, outputFile.empty() ? "pieces.bin" : outputFile);
+        } catch(const exception& e) {
+            cerr << e.what() << endl;
+            return EXIT_FAILURE;
+        }
+        return EXIT_SUCCESS;
+    }
+
+    if(!libraryFile.empty()) {
+        Puzzles solutions;
+        try {
+            PieceLibrary library(libraryFile);
+            bruteForceMagicCube(library.arrPieces(pieceNames), solutions);
+        } catch(const exception& e) {
+            cerr << e.what() << endl;
+            return EXIT_FAILURE;
+        }
+        cout << pieceNames << " : " << solutions.size() << " solutions" << endl;
+        removeSolutionByPermutation(solutions);
+        cout << pieceNames << " : " << solutions.size() << " solutions sans permutation des pieces semblables" << endl;
+        return EXIT_SUCCESS;
+    }
+
+    // Premiere solution, sans enumeration complete
+    if(nbWorkers != 0) {
+        SolverContext context(pieceNames);
+        RestartResult result;
+        try {
+            result = findFirstSolution(context, RestartOptions{budget, maxNodes}, nbWorkers, random_device{}());
+        } catch(const invalid_argument& e) {
+            cerr << e.what() << endl;
+            return EXIT_FAILURE;
+        }
+
+        if(result.found) {
+            cout << "Solution trouvee en " << result.seconds << "[s] (graine " << result.seed << ", "
+                 << result.restarts << " redemarrages, " << result.nodes << " noeuds) :" << endl << result.solution;
+        } else if(result.exhausted) {
+            cout << pieceNames << " n'a aucune solution (" << result.seconds << "[s])" << endl;
+        } else {
+            cout << "Aucune solution trouvee en " << result.nodes << " noeuds (" << result.seconds << "[s])" << endl;
+        }
+        return EXIT_SUCCESS;
+    }
+
+    // Index des solutions, construit une fois puis interroge sans recalcul
+    if(!indexFile.empty()) {
+        Puzzles solutions;
+        SolverContext(pieceNames).solve(solutions);
+        removeSolutionByPermutation(solutions);
+
+        SolutionIndex(solutions).save(indexFile);
+        cout << solutions.size() << " solutions indexees dans " << indexFile << endl;
+        return EXIT_SUCCESS;
+    }
+
+    if(!queryFile.empty()) {
+        try {
+            const SolutionIndex index = SolutionIndex::load(queryFile);
+            cout << index.size() << " solutions chargees" << endl;
+            if(socketPath.empty()) {
+                serveQueries(index, cin, cout);
+            } else {
+                serveQueries(index, socketPath);
+            }
+        } catch(const exception& e) {
+            cerr << e.what() << endl;
+            return EXIT_FAILURE;
+        }
+        return EXIT_SUCCESS;
+    }
+
+    // Solutions tirees au hasard
+    if(nbSamples != 0) {
+        auto start = chrono::steady_clock::now();
+        SolutionSampler sampler{SolverContext(pieceNames)};
+        chrono::duration<double> built = chrono::steady_clock::now() - start;
+        cout << pieceNames << " : " << sampler.count() << " solutions, " << sampler.size()
+             << " etats comptes en " << built.count() << "[s]" << endl;
+
+        if(sampler.count() == 0) {
+            return EXIT_SUCCESS;
+        }
+
+        mt19937_64 rng(random_device{}());
+        vector<uint_fast32_t> placed;
+        uint_fast32_t checksum = 0;
+        start = chrono::steady_clock::now();
+        for(unsigned long long i = 0; i < nbSamples; i++) {
+            sampler.sample(rng, placed);
+            checksum ^= placed.front();
+        }
+        chrono::duration<double> elapsed = chrono::steady_clock::now() - start;
+        cout << nbSamples << " tirages en " << elapsed.count() << "[s] (controle " << checksum << ")" << endl;
+        cout << "Dernier tirage :" << endl << sampler.toPuzzle(placed);
+        return EXIT_SUCCESS;
+    }
+
+    // Famille compressee des solutions
+    if(!diagramFile.empty()) {
+        SolverContext context(pieceNames);
+        SolutionDiagram diagram(context);
+
+        cout << pieceNames << " : " << diagram.count(diagram.getRoot()) << " solutions, "
+             << diagram.size() << " noeuds sur " << diagram.nbVars() << " placements" << endl;
+        if(diagram.count(diagram.getRoot()) != 0) {
+            mt19937_64 rng(random_device{}());
+            cout << "Solution tiree au hasard :" << endl << diagram.toPuzzle(diagram.sample(diagram.getRoot(), rng));
+        }
+
+        diagram.save(diagramFile);
+        return EXIT_SUCCESS;
+    }
 
     cout << "Generation des translations de toutes les pièces" << endl << endl;
 
@@ -41,6 +345,72 @@ int main () {
     ArrPieces allPieces;
     Pieces temp;
 
+    // Tableau de synthese des combinaisons
+    if(!summaryFile.empty()) {
+        vector<ArrPieces> allCombinations;
+        generateCombinations(allCombinations, allPieces);
+
+        ThreadPool pool;
+        vector<CombinationSummary> summaries = summarizeCombinations(pool, allCombinations);
+        sortSummaries(summaries, sortKey);
+
+        ofstream file(summaryFile, ios::trunc);
+        if(summaryFile.size() >= 5 && summaryFile.compare(summaryFile.size() - 5, 5, ".json") == 0) {
+            writeJson(file, summaries);
+        } else {
+            writeCsv(file, summaries);
+        }
+        writeCsv(cout, summaries);
+        return EXIT_SUCCESS;
+    }
+
+    // Comparaison des ordres de recherche sur toutes les combinaisons
+    if(heuristic) {
+        vector<ArrPieces> allCombinations;
+        generateCombinations(allCombinations, allPieces);
+
+        for(const ArrPieces& combination : allCombinations) {
+            for(const Pieces& p : combination) {
+                cout << p.at(0).getName() << " ";
+            }
+
+            const HeuristicSearch::Options modes[] = {{false, false}, {true, false}, {true, true}};
+            const char* labels[] = {": fixe : ", "| dynamique : ", "| damier : "};
+            for(size_t m = 0; m < 3; m++) {
+                HeuristicSearch search(combination, modes[m]);
+                auto start = chrono::steady_clock::now();
+                size_t count = search.count();
+                chrono::duration<double> elapsed = chrono::steady_clock::now() - start;
+                cout << labels[m] << count << " solutions, "
+                     << search.nodes() << " noeuds, " << elapsed.count() << "[s] ";
+            }
+            cout << endl;
+        }
+        return EXIT_SUCCESS;
+    }
+
+    // Recherche distribuee : un processus par shard, puis fusion
+    if(nbShards != 0 || !mergeFiles.empty()) {
+        vector<ArrPieces> allCombinations;
+        generateCombinations(allCombinations, allPieces);
+
+        if(mergeFiles.empty()) {
+            runShard(allCombinations, shard, nbShards,
+                     outputFile.empty() ? "shard_" + to_string(shard) + ".bin" : outputFile);
+            return EXIT_SUCCESS;
+        }
+
+        Puzzles solutions;
+        mergeShards(allCombinations, mergeFiles, solutions);
+
+        SolutionWriter file("allCombinaisons.txt");
+        for(const Puzzle& p : solutions) {
+            file.write(p);
+        }
+        file.close();
+        return EXIT_SUCCESS;
+    }
+
     //Stockage de l'ensemble des solutions sous forme d'objet
     allPieces.push_back(L::initAllPositions(temp, 0));
     temp.clear();
@@ -57,9 +427,15 @@ int main () {
     allPieces.push_back(C::initAllPositions(temp, 6));
     temp.clear();
 
-    //Brute force de l'ensemble des solutions
+    //Brute force de l'ensemble des solutions (solveur specialise a la compilation)
     Puzzles allSolutions;
-    bruteForceMagicCube(allPieces, allSolutions);
+    cout << "En cours de Brute force specialise... ";
+    auto now = time(nullptr);
+    auto store = [&allSolutions](const StandardSolver::Solution& s) {
+        allSolutions.push_back(StandardSolver::toPuzzle(s, {6, 5, 4, 3, 2, 1, 0}));
+    };
+    StandardSolver::solve(store);
+    cout << "Fini en " << time(nullptr) - now << "[s] (trouver : " << allSolutions.size() << ")" << endl;
 
     //Suppression des permutations des pièces semblables
     Puzzles solutions(allSolutions);
@@ -67,43 +443,43 @@ int main () {
 
     cout << endl;
 
-    // Ecriture dans un fichier de l'ensemble des solutions
-    ofstream file;
-    file.open("allSolutions.txt");
-    for(Puzzle p : solutions) {
-        p.displayForVTK(file);
+    // Ecriture dans un fichier de l'ensemble des solutions, en arriere-plan
+    // (close() attend la fin de l'ecriture, avant la longue recherche megaBruteForce)
+    SolutionWriter solutionsFile("allSolutions.txt");
+    for(const Puzzle& p : solutions) {
+        solutionsFile.write(p);
     }
-    file.close();
+    solutionsFile.close();
 
     cout << "Recherche des positions de la piece C ne donnant aucune solution : " << endl << endl;
 
     // Detection des pièces C ne donnant aucune solution
-    file.open("cWithOutSolution.txt");
+    SolutionWriter cFile("cWithOutSolution.txt");
     for(Piece& p : allPieces.back()){
         int count = countSolutionMatching(p, solutions);
         Puzzle puzzle(p);
 
         if(count == 0) {
             cout << "Position du C ne donnant aucune solution : " << endl;
-            puzzle.displayForVTK(file);
+            cFile.write(puzzle);
             cout << puzzle << endl;
         }
     }
-    file.close();
+    cFile.close();
 
     cout << "Recherche des possibilités de combinaisons avec les pièces C,L,T,S : " << endl << endl;
 
     //Brute force solutions avec des combinaisons différentes de pièce
 	allPieces.clear();
     solutions.clear();
-    megaBruteForce(allPieces, solutions);
+    megaBruteForce(allPieces, solutions, checkpointFile, checkpointInterval);
 
     // Ecriture dans un fichier de l'ensemble des solutions des combinaisons
-	file.open("allCombinaisons.txt");
-    for(Puzzle p : solutions) {
-        p.displayForVTK(file);
+    SolutionWriter combinationsFile("allCombinaisons.txt");
+    for(const Puzzle& p : solutions) {
+        combinationsFile.write(p);
     }
-    file.close();
+    combinationsFile.close();
 
     return EXIT_SUCCESS;
 }
@@ -39,6 +39,18 @@ uint_fast32_t toFastPiece(const Shape& s) {
     return mask;
 }
 
+Shape toShape(uint_fast32_t mask) {
+    Shape s;
+
+    for(int i = 0; i < 27; i++) {
+        if(mask & (uint_fast32_t(1) << i)) {
+            s.push_back(Point{i % 3, (i / 3) % 3, i / 9});
+        }
+    }
+
+    return s;
+}
+
 Piece::Piece() :shape(Shape()), mask(0), ownId(0), name(0) {
 
 }
@@ -25,6 +25,7 @@
 #include "shape.h"
 
 uint_fast32_t toFastPiece(const Shape& s);
+Shape toShape(uint_fast32_t mask);
 
 class Piece;
 
@@ -0,0 +1,306 @@
+/*
+ -----------------------------------------------------------------------------------
+ Laboratoire : ASD1 Cube magique
+ Fichier     : piece_library.cpp
+ Auteur(s)   : Jorge-André Fulgencio Esteves <jorgeand.fulgencioesteves@heig-vd.ch>,
+               Florian Schaufelberger <florian.schaufelberger@heig-vd.ch>,
+               Jonathan Zaehringer <jonathan.zaehringer@heig-vd.ch>
+
+ Date        : 27.03.2018
+
+ Compilateur : Apple LLVM version 9.0.0 (clang-900.0.39.2)
+               gcc version 5.4.0 20160609 (Ubuntu 5.4.0-6ubuntu1~16.04.9)
+               gcc version 7.2.0 (Debian 7.2.0-19)
+ -----------------------------------------------------------------------------------
+*/
+#include <fstream>
+#include <sstream>
+#include <stdexcept>
+#include <algorithm>
+#include <array>
+#include <cstdio>
+#include <cstring>
+
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+#include "piece_library.h"
+#include "binary_io.h"
+
+using namespace std;
+
+struct PieceLibrary::Header {
+    char magic[8];
+    uint32_t version;
+    uint32_t nbPieces;
+    uint32_t nbMasks;
+    uint32_t nbCells;
+};
+
+struct PieceLibrary::Record {
+    char name;
+    uint8_t nbCubes;
+    uint8_t nbOrientations;
+    uint8_t fixed;
+    uint32_t first;              // indice du premier masque de la piece
+    uint32_t count;              // nombre de placements
+};
+
+namespace {
+    const FileMagic MAGIC = {'A', 'S', 'D', 'P', 'L', 'I', 'B', '1'};
+
+    typedef array<int, 3> Cube;
+    typedef vector<Cube> Cubes;
+
+    // Translation vers l'origine puis tri, pour comparer deux orientations
+    Cubes normalize(Cubes cubes) {
+        for(size_t axis = 0; axis < 3; axis++) {
+            int low = min_element(cubes.begin(), cubes.end(), [axis](const Cube& a, const Cube& b) { return a[axis] < b[axis]; })->at(axis);
+            for(Cube& c : cubes) {
+                c[axis] -= low;
+            }
+        }
+        sort(cubes.begin(), cubes.end());
+        return cubes;
+    }
+
+    // Rotations d'un quart de tour autour de x et de z, qui engendrent les 24 rotations
+    Cubes rotateX(const Cubes& cubes) {
+        Cubes r;
+        for(const Cube& c : cubes) {
+            r.push_back(Cube{c[0], -c[2], c[1]});
+        }
+        return normalize(r);
+    }
+
+    Cubes rotateZ(const Cubes& cubes) {
+        Cubes r;
+        for(const Cube& c : cubes) {
+            r.push_back(Cube{-c[1], c[0], c[2]});
+        }
+        return normalize(r);
+    }
+
+    vector<Cubes> orientations(const Cubes& cubes, bool fixed) {
+        vector<Cubes> all{normalize(cubes)};
+        for(size_t i = 0; i < all.size() && !fixed; i++) {
+            for(const Cubes& r : {rotateX(all[i]), rotateZ(all[i])}) {
+                if(find(all.begin(), all.end(), r) == all.end()) {
+                    all.push_back(r);
+                }
+            }
+        }
+        return all;
+    }
+
+    struct Definition {
+        char name;
+        bool fixed;
+        Cubes cubes;
+    };
+
+    vector<Definition> parse(const string& descriptionFile) {
+        ifstream file(descriptionFile);
+        if(!file) {
+            throw runtime_error("PieceLibrary::compile : impossible de lire " + descriptionFile);
+        }
+
+        vector<Definition> definitions;
+        size_t lineNumber = 0;
+        for(string line; getline(file, line);) {
+            ++lineNumber;
+            line = line.substr(0, line.find('#'));
+            istringstream fields(line);
+            string word;
+            if(!(fields >> word)) {
+                continue;
+            }
+
+            const string where = descriptionFile + ":" + to_string(lineNumber);
+            if(word.size() != 1) {
+                throw invalid_argument(where + " : le nom d'une piece est un seul caractere");
+            }
+            Definition d{word[0], false, {}};
+            if(any_of(definitions.begin(), definitions.end(), [&d](const Definition& o) { return o.name == d.name; })) {
+                throw invalid_argument(where + " : piece " + word + " deja definie");
+            }
+
+            while(fields >> word) {
+                Cube c;
+                char comma1 = 0, comma2 = 0;
+                istringstream cube(word);
+                if(word == "fixed") {
+                    d.fixed = true;
+                } else if(cube >> c[0] >> comma1 >> c[1] >> comma2 >> c[2] && comma1 == ',' && comma2 == ',' && cube.eof()) {
+                    d.cubes.push_back(c);
+                } else {
+                    throw invalid_argument(where + " : cube invalide \"" + word + "\"");
+                }
+            }
+
+            if(d.cubes.empty()) {
+                throw invalid_argument(where + " : piece sans cube");
+            }
+            const Cubes sorted = normalize(d.cubes);
+            if(adjacent_find(sorted.begin(), sorted.end()) != sorted.end()) {
+                throw invalid_argument(where + " : cube repete");
+            }
+            definitions.push_back(d);
+        }
+        return definitions;
+    }
+}
+
+void PieceLibrary::compile(const string& descriptionFile, const string& libraryFile) {
+    const vector<Definition> definitions = parse(descriptionFile);
+
+    // Meme ordre que Piece::generateAllPositions : translation puis orientation
+    vector<uint32_t> masks;
+    vector<Record> records;
+    for(const Definition& d : definitions) {
+        const vector<Cubes> shapes = orientations(d.cubes, d.fixed);
+        const size_t first = masks.size();
+        for(int x = 0; x < 3; x++) {
+            for(int y = 0; y < 3; y++) {
+                for(int z = 0; z < 3; z++) {
+                    for(const Cubes& s : shapes) {
+                        // Le masque n'est calcule qu'une fois tous les cubes dans le cube 3x3x3
+                        const bool inside = all_of(s.begin(), s.end(), [x, y, z](const Cube& c) {
+                            return c[0] + x < 3 && c[1] + y < 3 && c[2] + z < 3;
+                        });
+                        if(inside) {
+                            uint32_t mask = 0;
+                            for(const Cube& c : s) {
+                                mask |= uint32_t(1) << ((c[0] + x) + 3 * (c[1] + y) + 9 * (c[2] + z));
+                            }
+                            masks.push_back(mask);
+                        }
+                    }
+                }
+            }
+        }
+
+        if(masks.size() == first) {
+            throw invalid_argument("PieceLibrary::compile : la piece " + string(1, d.name) + " ne tient pas dans le cube");
+        }
+        records.push_back(Record{d.name, uint8_t(d.cubes.size()), uint8_t(shapes.size()), uint8_t(d.fixed),
+                                               uint32_t(first), uint32_t(masks.size() - first)});
+    }
+
+    const string tmpName = libraryFile + ".tmp";
+    ofstream file(tmpName, ios::binary | ios::trunc);
+
+    Header header;
+    memcpy(header.magic, MAGIC, sizeof(MAGIC));
+    header.version = VERSION;
+    header.nbPieces = uint32_t(records.size());
+    header.nbMasks = uint32_t(masks.size());
+    header.nbCells = 27;
+    writeBinary(file, header);
+    for(const Record& r : records) {
+        writeBinary(file, r);
+    }
+    for(uint32_t m : masks) {
+        writeBinary(file, m);
+    }
+
+    file.close();
+    if(!file || rename(tmpName.c_str(), libraryFile.c_str()) != 0) {
+        throw runtime_error("PieceLibrary::compile : impossible d'ecrire " + libraryFile);
+    }
+}
+
+PieceLibrary::PieceLibrary(const string& fileName) : data(MAP_FAILED), length(0) {
+    static_assert(sizeof(Header) == 24 && sizeof(Record) == 12, "Format de fichier inattendu");
+
+    const int fd = open(fileName.c_str(), O_RDONLY);
+    struct stat info;
+    if(fd < 0 || fstat(fd, &info) != 0) {
+        if(fd >= 0) {
+            close(fd);
+        }
+        throw runtime_error("PieceLibrary : impossible d'ouvrir " + fileName);
+    }
+    length = size_t(info.st_size);
+    if(length >= sizeof(Header)) {
+        data = mmap(nullptr, length, PROT_READ, MAP_PRIVATE, fd, 0);
+    }
+    close(fd);
+    if(data == MAP_FAILED) {
+        throw runtime_error("PieceLibrary : " + fileName + " n'est pas une table de pieces");
+    }
+
+    header = static_cast<const Header*>(data);
+    records = reinterpret_cast<const Record*>(header + 1);
+    masks = reinterpret_cast<const uint32_t*>(records + header->nbPieces);
+
+    const char* error = nullptr;
+    if(memcmp(header->magic, MAGIC, sizeof(MAGIC)) != 0) {
+        error = " n'est pas une table de pieces";
+    } else if(header->version != VERSION || header->nbCells != 27) {
+        error = " est d'une autre version";
+    } else if(length != sizeof(Header) + header->nbPieces * sizeof(Record) + header->nbMasks * sizeof(uint32_t)) {
+        error = " est tronque";
+    } else {
+        for(size_t i = 0; i < header->nbPieces && !error; i++) {
+            if(uint64_t(records[i].first) + records[i].count > header->nbMasks) {
+                error = " est corrompu";
+            }
+        }
+    }
+    if(error) {
+        munmap(data, length);
+        throw runtime_error("PieceLibrary : " + fileName + error);
+    }
+}
+
+PieceLibrary::~PieceLibrary() {
+    munmap(data, length);
+}
+
+size_t PieceLibrary::size() const {
+    return header->nbPieces;
+}
+
+char PieceLibrary::getName(size_t piece) const {
+    return records[piece].name;
+}
+
+size_t PieceLibrary::nbCubes(size_t piece) const {
+    return records[piece].nbCubes;
+}
+
+size_t PieceLibrary::nbPlacements(size_t piece) const {
+    return records[piece].count;
+}
+
+const uint32_t* PieceLibrary::placements(size_t piece) const {
+    return masks + records[piece].first;
+}
+
+size_t PieceLibrary::find(char name) const {
+    for(size_t i = 0; i < size(); i++) {
+        if(records[i].name == name) {
+            return i;
+        }
+    }
+    throw invalid_argument(string("PieceLibrary : piece inconnue ") + name);
+}
+
+Pieces& PieceLibrary::initAllPositions(size_t piece, Pieces& pieces, unsigned id) const {
+    const uint32_t* first = placements(piece);
+    for(const uint32_t* m = first; m != first + nbPlacements(piece); m++) {
+        pieces.push_back(Piece(toShape(*m), *m, id, getName(piece)));
+    }
+    return pieces;
+}
+
+ArrPieces PieceLibrary::arrPieces(const string& names) const {
+    ArrPieces allPieces(names.size());
+    for(size_t i = 0; i < names.size(); i++) {
+        initAllPositions(find(names[i]), allPieces[i], unsigned(i));
+    }
+    return allPieces;
+}
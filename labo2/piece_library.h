@@ -0,0 +1,102 @@
+/*
+ -----------------------------------------------------------------------------------
+ Laboratoire : ASD1 Cube magique
+ Fichier     : piece_library.h
+ Auteur(s)   : Jorge-André Fulgencio Esteves <jorgeand.fulgencioesteves@heig-vd.ch>,
+               Florian Schaufelberger <florian.schaufelberger@heig-vd.ch>,
+               Jonathan Zaehringer <jonathan.zaehringer@heig-vd.ch>
+
+ Date        : 27.03.2018
+
+ Compilateur : Apple LLVM version 9.0.0 (clang-900.0.39.2)
+               gcc version 5.4.0 20160609 (Ubuntu 5.4.0-6ubuntu1~16.04.9)
+               gcc version 7.2.0 (Debian 7.2.0-19)
+ -----------------------------------------------------------------------------------
+*/
+#ifndef PIECE_LIBRARY_H
+#define PIECE_LIBRARY_H
+
+#include <string>
+#include <cstdint>
+#include <cstddef>
+
+#include "magic_cube.h"
+
+/**
+ * Table de placements compilee par PieceLibrary::compile, projetee en memoire
+ * (mmap) : le chargement ne fait que valider l'en-tete, les masques sont lus
+ * directement dans le fichier.
+ */
+class PieceLibrary {
+public :
+    static const uint32_t VERSION = 1;
+
+    /**
+     * @brief Compilation d'un fichier de description de pieces en table de placements
+     *
+     * Chaque ligne non vide du fichier decrit une piece par son nom (un caractere),
+     * le mot-cle optionnel "fixed" et la liste de ses cubes unitaires "x,y,z" :
+     *
+     *     # commentaire
+     *     C fixed 0,0,0 1,0,0 0,1,0
+     *     L 0,0,0 1,0,0 2,0,0 0,1,0
+     *
+     * Les 24 rotations de chaque piece sont generees (une seule pour une piece
+     * "fixed", ce qui brise la symetrie du cube), puis toutes leurs translations
+     * dans le cube 3x3x3. Le resultat est ecrit a cote puis renomme.
+     *
+     * @exception std::invalid_argument si la description est invalide
+     * @exception std::runtime_error si un fichier ne peut pas etre lu ou ecrit
+     */
+    static void compile(const std::string& descriptionFile, const std::string& libraryFile);
+
+private :
+    struct Header;
+    struct Record;
+
+    void* data;
+    size_t length;
+    const Header* header;
+    const Record* records;
+    const uint32_t* masks;
+
+public :
+    /**
+     * @exception std::runtime_error si le fichier ne peut pas etre projete,
+     *            est tronque ou d'une autre version
+     */
+    explicit PieceLibrary(const std::string& fileName);
+    ~PieceLibrary();
+
+    PieceLibrary(const PieceLibrary&) = delete;
+    PieceLibrary& operator = (const PieceLibrary&) = delete;
+
+    size_t size() const;
+    char getName(size_t piece) const;
+    size_t nbCubes(size_t piece) const;
+    size_t nbPlacements(size_t piece) const;
+    const uint32_t* placements(size_t piece) const;
+
+    /**
+     * @brief Indice de la piece de ce nom
+     *
+     * @exception std::invalid_argument si la piece n'existe pas
+     */
+    size_t find(char name) const;
+
+    /**
+     * @brief Ajoute a pieces tous les placements d'une piece, comme Piece::initAllPositions
+     */
+    Pieces& initAllPositions(size_t piece, Pieces& pieces, unsigned id) const;
+
+    /**
+     * @brief Placements de chaque piece nommee, la i-eme recevant l'identifiant i
+     *
+     * @param[in] names noms des pieces, "LLLLTSC" pour le jeu standard
+     *
+     * @exception std::invalid_argument si une piece n'existe pas
+     */
+    ArrPieces arrPieces(const std::string& names) const;
+};
+
+#endif
@@ -15,61 +15,43 @@
 */
 #include <vector>
 #include <iostream>
-#include <iomanip>
+#include <string>
 
 #include "puzzle.h"
+#include "render.h"
 
 using namespace std;
 
-void Puzzle::displayForVTK(ofstream& file) {
-    std::vector<int> tab(27, -1);
-
-    for(Piece part : pieces) {
-        Shape s = part.getShape();
-        for(Point p : s) {
-            tab[size_t(p[0] + 3 * p[1] + 9 * p[2])] = int(part.getId());
+namespace {
+    CellLabels labelsOf(const Pieces& pieces) {
+        CellLabels labels = emptyCells();
+        for(const Piece& part : pieces) {
+            labelCells(labels, part.getMask(), int(part.getId()));
         }
+        return labels;
     }
+}
 
-    for (int i = 2; i >= 0; i--) {
-        for (int j = 0; j < 3; ++j) {
-            for (int k = 0; k < 3; ++k) {
-                file << tab[size_t(3 * (i + 3 * j) + k)];
-                if(k != 2) {
-                    file << ",";
-                }
-            }
-            file << ",";
-        }
-    }
-    file << endl;
+void Puzzle::render(string& out) const {
+    appendGrid(out, labelsOf(pieces));
 }
 
-std::ostream& operator << (std::ostream& os, const Puzzle& rhs) {
-    std::vector<int> tab(27, -1);
+void Puzzle::renderForVTK(string& out) const {
+    appendForVTK(out, labelsOf(pieces));
+}
 
-    for(Piece part : rhs.pieces) {
-        Shape s = part.getShape();
-        for(Point p : s) {
-            tab[size_t(p[0] + 3 * p[1] + 9 * p[2])] = int(part.getId());
-        }
-    }
+void Puzzle::displayForVTK(ofstream& file) {
+    string out;
+    renderForVTK(out);
+    file.write(out.data(), streamsize(out.size()));
+}
 
-    for (int i = 2; i >= 0; i--) {
-        for (int j = 0; j < 3; ++j) {
-            os << "{";
-            for (int k = 0; k < 3; ++k) {
-                os << std::setw(2) << tab[size_t(3 * (i + 3 * j) + k)];
-                if(k != 2) {
-                    os << ", ";
-                }
-            }
-            os << "}  ";
-        }
-        os << endl;
-    } 
-	os << endl;
-	return os;
+std::ostream& operator << (std::ostream& os, const Puzzle& rhs) {
+    // Tampon reutilise d'un appel a l'autre : pas d'allocation en regime etabli
+    static thread_local string out;
+    out.clear();
+    rhs.render(out);
+    return os.write(out.data(), streamsize(out.size()));
 }
 
 Puzzle::Puzzle()  : fastcube(0), pieces({}) {
@@ -83,6 +65,10 @@ Pieces& Puzzle::getPieces() {
     return pieces;
 }
 
+const Pieces& Puzzle::getPieces() const {
+    return pieces;
+}
+
 bool Puzzle::tryToInsert(const Piece& piece) {
     if((fastcube & piece.getMask()) == 0) {
         fastcube += piece.getMask();
@@ -18,6 +18,7 @@
 
 #include <vector>
 #include <fstream>
+#include <string>
 
 #include "piece.h"
 
@@ -36,8 +37,12 @@ class Puzzle {
         Puzzle();
         Puzzle(Piece piece);
         Pieces& getPieces();
+        const Pieces& getPieces() const;
         bool tryToInsert(const Piece& piece);
         void popLastPiece();
+        //Ajoutent a out le texte de operator << et de displayForVTK
+        void render(std::string& out) const;
+        void renderForVTK(std::string& out) const;
     void displayForVTK(std::ofstream& file);
 };
 
@@ -0,0 +1,107 @@
+/*
+ -----------------------------------------------------------------------------------
+ Laboratoire : ASD1 Cube magique
+ Fichier     : render.cpp
+ Auteur(s)   : Jorge-André Fulgencio Esteves <jorgeand.fulgencioesteves@heig-vd.ch>,
+               Florian Schaufelberger <florian.schaufelberger@heig-vd.ch>,
+               Jonathan Zaehringer <jonathan.zaehringer@heig-vd.ch>
+
+ Date        : 27.03.2018
+
+ Compilateur : Apple LLVM version 9.0.0 (clang-900.0.39.2)
+               gcc version 5.4.0 20160609 (Ubuntu 5.4.0-6ubuntu1~16.04.9)
+               gcc version 7.2.0 (Debian 7.2.0-19)
+ -----------------------------------------------------------------------------------
+*/
+#include <algorithm>
+
+#include "render.h"
+
+using namespace std;
+
+namespace {
+    // Rang d'affichage de chaque case : la case x + 3y + 9z est affichee en
+    // 9 * (2 - y) + 3 * z + x (boucles i = 2..0, j, k sur l'indice 3 * (i + 3j) + k)
+    struct Slots {
+        uint8_t of[27];
+
+        Slots() {
+            for(int cell = 0; cell < 27; cell++) {
+                of[cell] = uint8_t(9 * (2 - cell / 3 % 3) + 3 * (cell / 9) + cell % 3);
+            }
+        }
+    };
+
+    // Libelles deja formates des identifiants -1 a 254, avec et sans largeur minimale de 2
+    struct Label {
+        char text[4];
+        uint8_t size;
+    };
+
+    struct Labels {
+        static const int COUNT = 256;
+        Label plain[COUNT];
+        Label padded[COUNT];
+
+        Labels() {
+            for(int i = 0; i < COUNT; i++) {
+                const string s = to_string(i - 1);
+                const string p = s.size() < 2 ? " " + s : s;
+                plain[i].size = uint8_t(s.copy(plain[i].text, sizeof(plain[i].text)));
+                padded[i].size = uint8_t(p.copy(padded[i].text, sizeof(padded[i].text)));
+            }
+        }
+    };
+
+    const Slots SLOTS;
+    const Labels LABELS;
+
+    void append(string& out, int id, const Label* table) {
+        if(id + 1 < Labels::COUNT) {
+            const Label& l = table[id + 1];
+            out.append(l.text, l.size);
+        } else {
+            out += to_string(id);
+        }
+    }
+}
+
+CellLabels emptyCells() {
+    CellLabels labels;
+    labels.fill(-1);
+    return labels;
+}
+
+void labelCells(CellLabels& labels, uint_fast32_t mask, int id) {
+    for(uint32_t m = uint32_t(mask); m != 0; m &= m - 1) {
+        labels[SLOTS.of[__builtin_ctz(m)]] = id;
+    }
+}
+
+void appendGrid(string& out, const CellLabels& labels) {
+    for(size_t row = 0; row < 27; row += 9) {
+        for(size_t group = row; group < row + 9; group += 3) {
+            out += '{';
+            append(out, labels[group], LABELS.padded);
+            out += ", ";
+            append(out, labels[group + 1], LABELS.padded);
+            out += ", ";
+            append(out, labels[group + 2], LABELS.padded);
+            out += "}  ";
+        }
+        out += '\n';
+    }
+    out += '\n';
+}
+
+void appendForVTK(string& out, const CellLabels& labels) {
+    for(size_t group = 0; group < 27; group += 3) {
+        append(out, labels[group], LABELS.plain);
+        out += ',';
+        append(out, labels[group + 1], LABELS.plain);
+        out += ',';
+        append(out, labels[group + 2], LABELS.plain);
+        out += ',';
+    }
+    out += '\n';
+}
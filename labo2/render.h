@@ -0,0 +1,49 @@
+/*
+ -----------------------------------------------------------------------------------
+ Laboratoire : ASD1 Cube magique
+ Fichier     : render.h
+ Auteur(s)   : Jorge-André Fulgencio Esteves <jorgeand.fulgencioesteves@heig-vd.ch>,
+               Florian Schaufelberger <florian.schaufelberger@heig-vd.ch>,
+               Jonathan Zaehringer <jonathan.zaehringer@heig-vd.ch>
+
+ Date        : 27.03.2018
+
+ Compilateur : Apple LLVM version 9.0.0 (clang-900.0.39.2)
+               gcc version 5.4.0 20160609 (Ubuntu 5.4.0-6ubuntu1~16.04.9)
+               gcc version 7.2.0 (Debian 7.2.0-19)
+ -----------------------------------------------------------------------------------
+*/
+#ifndef RENDER_H
+#define RENDER_H
+
+#include <array>
+#include <string>
+#include <cstdint>
+
+/**
+ * Identifiant de la piece occupant chaque case du cube (-1 si vide), range
+ * directement dans l'ordre d'affichage : couche y = 2 a 0, puis z, puis x.
+ */
+typedef std::array<int, 27> CellLabels;
+
+/**
+ * @brief Toutes les cases vides
+ */
+CellLabels emptyCells();
+
+/**
+ * @brief Marque les cases d'un placement (bit x + 3 * y + 9 * z) avec id
+ */
+void labelCells(CellLabels& labels, uint_fast32_t mask, int id);
+
+/**
+ * @brief Ajoute a out le meme texte que operator << (ostream&, const Puzzle&)
+ */
+void appendGrid(std::string& out, const CellLabels& labels);
+
+/**
+ * @brief Ajoute a out le meme texte que Puzzle::displayForVTK
+ */
+void appendForVTK(std::string& out, const CellLabels& labels);
+
+#endif
@@ -0,0 +1,168 @@
+/*
+ -----------------------------------------------------------------------------------
+ Laboratoire : ASD1 Cube magique
+ Fichier     : restart_search.cpp
+ Auteur(s)   : Jorge-André Fulgencio Esteves <jorgeand.fulgencioesteves@heig-vd.ch>,
+               Florian Schaufelberger <florian.schaufelberger@heig-vd.ch>,
+               Jonathan Zaehringer <jonathan.zaehringer@heig-vd.ch>
+
+ Date        : 27.03.2018
+
+ Compilateur : Apple LLVM version 9.0.0 (clang-900.0.39.2)
+               gcc version 5.4.0 20160609 (Ubuntu 5.4.0-6ubuntu1~16.04.9)
+               gcc version 7.2.0 (Debian 7.2.0-19)
+ -----------------------------------------------------------------------------------
+*/
+#include <algorithm>
+#include <stdexcept>
+#include <chrono>
+#include <mutex>
+
+#include "restart_search.h"
+#include "thread_pool.h"
+
+using namespace std;
+
+namespace {
+    // Sans solution possible, aucun essai n'epuiserait l'arbre en un temps
+    // raisonnable et les redemarrages ne s'arreteraient jamais
+    void checkOptions(const SolverContext& context, const RestartOptions& options) {
+        if(options.baseBudget == 0) {
+            throw invalid_argument("RestartSearch : le budget d'un essai doit etre positif");
+        }
+
+        size_t cells = 0;
+        for(char name : context.getPieceNames()) {
+            cells += size_t(__builtin_popcount(uint32_t(SolverContext::placementsOf(name).front())));
+        }
+        const size_t freeCells = 27 - size_t(__builtin_popcount(uint32_t(context.getBlocked() & ((1u << 27) - 1))));
+        if(cells != freeCells) {
+            throw invalid_argument("RestartSearch : les pieces " + context.getPieceNames() + " couvrent "
+                                   + to_string(cells) + " cases pour " + to_string(freeCells) + " cases libres");
+        }
+    }
+}
+
+unsigned long long luby(unsigned long long i) {
+    // Si i = 2^k - 1, la valeur est 2^(k-1) ; sinon on se ramene au debut du bloc precedent
+    for(unsigned long long k = 1;; k++) {
+        const unsigned long long end = (1ull << k) - 1;
+        if(i == end) {
+            return 1ull << (k - 1);
+        }
+        if(i < end) {
+            return luby(i - (1ull << (k - 1)) + 1);
+        }
+    }
+}
+
+RestartSearch::RestartSearch(const SolverContext& context, uint64_t seed)
+    : context(context), rng(seed), seed(seed), candidates(context.getPlacements().size()),
+      placed(context.getPlacements().size()), budget(0), nbNodes(0), aborted(false) {
+}
+
+bool RestartSearch::search(uint_fast32_t cube, size_t index, const atomic<bool>& stop) {
+    if(index == 0) {
+        return true;
+    }
+    if(++nbNodes > budget || stop.load(memory_order_relaxed)) {
+        aborted = true;
+        return false;
+    }
+
+    vector<uint_fast32_t>& order = candidates[index - 1];
+    order.clear();
+    for(uint_fast32_t m : context.getPlacements()[index - 1]) {
+        if((cube & m) == 0) {
+            order.push_back(m);
+        }
+    }
+    shuffle(order.begin(), order.end(), rng);
+
+    for(uint_fast32_t m : order) {
+        placed[index - 1] = m;
+        if(search(cube | m, index - 1, stop)) {
+            return true;
+        }
+        if(aborted) {
+            return false;
+        }
+    }
+    return false;
+}
+
+RestartResult RestartSearch::run(const RestartOptions& options, const atomic<bool>& stop) {
+    checkOptions(context, options);
+
+    RestartResult result{false, false, Puzzle(), 0, 0, seed, 0};
+    const auto start = chrono::steady_clock::now();
+    unsigned long long total = 0;
+
+    for(unsigned long long attempt = 1; !stop.load(); attempt++) {
+        budget = options.baseBudget * luby(attempt);
+        if(options.maxNodes != 0) {
+            if(total >= options.maxNodes) {
+                break;
+            }
+            budget = min(budget, options.maxNodes - total);
+        }
+        nbNodes = 0;
+        aborted = false;
+
+        const bool found = search(context.getBlocked(), placed.size(), stop);
+        total += nbNodes;
+        result.restarts = attempt - 1;
+
+        if(found) {
+            const string& names = context.getPieceNames();
+            for(size_t i = placed.size(); i-- > 0;) {
+                result.solution.tryToInsert(Piece(toShape(placed[i]), placed[i], unsigned(i), names[i]));
+            }
+            result.found = true;
+            break;
+        }
+        if(!aborted) {
+            result.exhausted = true;
+            break;
+        }
+    }
+
+    result.nodes = total;
+    result.seconds = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+    return result;
+}
+
+RestartResult findFirstSolution(const SolverContext& context, const RestartOptions& options,
+                                unsigned nbWorkers, uint64_t seed) {
+    checkOptions(context, options);
+
+    atomic<bool> stop(false);
+    mutex access;
+    RestartResult best{false, false, Puzzle(), 0, 0, seed, 0};
+    const auto start = chrono::steady_clock::now();
+
+    {
+        ThreadPool pool(max(nbWorkers, 1u));
+        for(unsigned w = 0; w < pool.size(); w++) {
+            pool.submit([&, w]() {
+                RestartSearch search(context, seed + w);
+                RestartResult result = search.run(options, stop);
+
+                lock_guard<std::mutex> lock(access);
+                if((result.found || result.exhausted) && !best.found && !best.exhausted) {
+                    best = result;
+                    best.seconds = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+                    stop = true;
+                } else if(!best.found && !best.exhausted) {
+                    // Tous abandonnes sur maxNodes : total des noeuds de tous les workers
+                    best.nodes += result.nodes;
+                }
+            });
+        }
+    }
+
+    if(!best.found && !best.exhausted) {
+        best.seconds = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+    }
+    return best;
+}
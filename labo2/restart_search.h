@@ -0,0 +1,96 @@
+/*
+ -----------------------------------------------------------------------------------
+ Laboratoire : ASD1 Cube magique
+ Fichier     : restart_search.h
+ Auteur(s)   : Jorge-André Fulgencio Esteves <jorgeand.fulgencioesteves@heig-vd.ch>,
+               Florian Schaufelberger <florian.schaufelberger@heig-vd.ch>,
+               Jonathan Zaehringer <jonathan.zaehringer@heig-vd.ch>
+
+ Date        : 27.03.2018
+
+ Compilateur : Apple LLVM version 9.0.0 (clang-900.0.39.2)
+               gcc version 5.4.0 20160609 (Ubuntu 5.4.0-6ubuntu1~16.04.9)
+               gcc version 7.2.0 (Debian 7.2.0-19)
+ -----------------------------------------------------------------------------------
+*/
+#ifndef RESTART_SEARCH_H
+#define RESTART_SEARCH_H
+
+#include <vector>
+#include <random>
+#include <atomic>
+#include <cstdint>
+
+#include "solver_context.h"
+
+struct RestartOptions {
+    unsigned long long baseBudget;   // noeuds de l'essai i : baseBudget * luby(i)
+    unsigned long long maxNodes;     // abandon au-dela, 0 pour ne jamais abandonner
+};
+
+struct RestartResult {
+    bool found;
+    bool exhausted;                  // un essai a parcouru tout l'arbre : aucune solution
+    Puzzle solution;
+    unsigned long long nodes;        // noeuds visites par le worker gagnant (par tous, sinon)
+    unsigned long long restarts;
+    uint64_t seed;                   // graine du worker gagnant
+    double seconds;                  // temps jusqu'a la premiere solution
+};
+
+/**
+ * @brief Suite de Luby : 1, 1, 2, 1, 1, 2, 4, 1, 1, 2, 1, 1, 2, 4, 8, ...
+ *
+ * @param[in] i rang dans la suite, a partir de 1
+ */
+unsigned long long luby(unsigned long long i);
+
+/**
+ * Recherche d'une seule solution par essais successifs.
+ *
+ * Chaque essai est une recherche en profondeur, dans l'ordre des pieces de
+ * bruteForceMagicCube, mais dont les placements de chaque noeud sont tires
+ * dans un ordre aleatoire. Un essai qui depasse son budget de noeuds est
+ * abandonne et le suivant repart de zero avec un budget tire de la suite de
+ * Luby, ce qui evite de rester bloque dans un grand sous-arbre sans solution.
+ */
+class RestartSearch {
+private :
+    const SolverContext& context;
+    std::mt19937_64 rng;
+    uint64_t seed;
+    std::vector<std::vector<uint_fast32_t>> candidates;   // placements libres, par profondeur
+    std::vector<uint_fast32_t> placed;                     // placement de chaque piece
+    unsigned long long budget;
+    unsigned long long nbNodes;
+    bool aborted;
+
+    bool search(uint_fast32_t cube, size_t index, const std::atomic<bool>& stop);
+
+public :
+    RestartSearch(const SolverContext& context, uint64_t seed);
+
+    /**
+     * @brief Essais successifs jusqu'a une solution, l'epuisement de l'arbre,
+     *        le depassement de options.maxNodes ou la levee de stop
+     *
+     * @exception std::invalid_argument si options.baseBudget est nul ou si les
+     *            pieces ne couvrent pas exactement les cases libres
+     */
+    RestartResult run(const RestartOptions& options, const std::atomic<bool>& stop);
+};
+
+/**
+ * @brief Portefeuille de nbWorkers recherches de graines differentes
+ *
+ * La premiere qui trouve une solution (ou prouve qu'il n'y en a pas) arrete
+ * toutes les autres.
+ *
+ * @param[in] seed graine du premier worker, les suivants utilisent seed + 1, seed + 2, ...
+ *
+ * @exception std::invalid_argument comme RestartSearch::run
+ */
+RestartResult findFirstSolution(const SolverContext& context, const RestartOptions& options,
+                                unsigned nbWorkers, uint64_t seed);
+
+#endif
@@ -0,0 +1,162 @@
+/*
+ -----------------------------------------------------------------------------------
+ Laboratoire : ASD1 Cube magique
+ Fichier     : result_cache.cpp
+ Auteur(s)   : Jorge-André Fulgencio Esteves <jorgeand.fulgencioesteves@heig-vd.ch>,
+               Florian Schaufelberger <florian.schaufelberger@heig-vd.ch>,
+               Jonathan Zaehringer <jonathan.zaehringer@heig-vd.ch>
+
+ Date        : 27.03.2018
+
+ Compilateur : Apple LLVM version 9.0.0 (clang-900.0.39.2)
+               gcc version 5.4.0 20160609 (Ubuntu 5.4.0-6ubuntu1~16.04.9)
+               gcc version 7.2.0 (Debian 7.2.0-19)
+ -----------------------------------------------------------------------------------
+*/
+#include <vector>
+#include <map>
+#include <algorithm>
+#include <fstream>
+#include <stdexcept>
+
+#include "result_cache.h"
+#include "solver_context.h"
+#include "symmetry.h"
+
+using namespace std;
+
+namespace {
+    // Symetries laissant invariant l'ensemble des placements d'une piece
+    vector<bool> invariantSymmetries(char name) {
+        vector<uint_fast32_t> placements = SolverContext::placementsOf(name);
+        sort(placements.begin(), placements.end());
+
+        vector<bool> invariant(NB_SYMMETRIES);
+        for(size_t g = 0; g < NB_SYMMETRIES; g++) {
+            vector<uint_fast32_t> images;
+            for(uint_fast32_t m : placements) {
+                images.push_back(transform(m, g));
+            }
+            sort(images.begin(), images.end());
+            invariant[g] = images == placements;
+        }
+        return invariant;
+    }
+
+    const vector<bool>& symmetriesOf(char name) {
+        static const map<char, vector<bool>> table = {
+            {'C', invariantSymmetries('C')},
+            {'T', invariantSymmetries('T')},
+            {'S', invariantSymmetries('S')},
+            {'L', invariantSymmetries('L')},
+        };
+
+        auto it = table.find(name);
+        if(it == table.end()) {
+            throw invalid_argument(string("ResultCache : piece inconnue ") + name);
+        }
+        return it->second;
+    }
+}
+
+size_t ResultCache::KeyHash::operator () (const Key& key) const {
+    return hash<string>()(key.first) ^ (hash<uint_fast32_t>()(key.second) << 1);
+}
+
+ResultCache::ResultCache(size_t capacity) : capacity(max(capacity, size_t(1))), nbHits(0), nbMisses(0) {
+}
+
+ResultCache::Key ResultCache::canonical(const string& pieceNames, uint_fast32_t blocked) {
+    string names(pieceNames);
+    sort(names.begin(), names.end());
+
+    uint_fast32_t best = blocked;
+    for(size_t g = 0; g < NB_SYMMETRIES; g++) {
+        if(all_of(names.begin(), names.end(), [g](char name) { return symmetriesOf(name)[g]; })) {
+            best = min(best, transform(blocked, g));
+        }
+    }
+
+    return Key(names, best);
+}
+
+size_t ResultCache::count(const string& pieceNames, uint_fast32_t blocked) {
+    Key key = canonical(pieceNames, blocked);
+    {
+        lock_guard<std::mutex> lock(access);
+        auto it = index.find(key);
+        if(it != index.end()) {
+            entries.splice(entries.begin(), entries, it->second);
+            ++nbHits;
+            return it->second->second;
+        }
+        ++nbMisses;
+    }
+
+    size_t n = SolverContext(key.first, key.second).count();
+
+    lock_guard<std::mutex> lock(access);
+    insert(key, n);
+    return n;
+}
+
+void ResultCache::insert(const Key& key, size_t count) {
+    auto it = index.find(key);
+    if(it != index.end()) {
+        entries.splice(entries.begin(), entries, it->second);
+        return;
+    }
+
+    entries.emplace_front(key, count);
+    index[key] = entries.begin();
+
+    if(entries.size() > capacity) {
+        index.erase(entries.back().first);
+        entries.pop_back();
+    }
+}
+
+size_t ResultCache::size() const {
+    lock_guard<std::mutex> lock(access);
+    return entries.size();
+}
+
+size_t ResultCache::hits() const {
+    lock_guard<std::mutex> lock(access);
+    return nbHits;
+}
+
+size_t ResultCache::misses() const {
+    lock_guard<std::mutex> lock(access);
+    return nbMisses;
+}
+
+bool ResultCache::load(const string& fileName) {
+    ifstream file(fileName);
+    if(!file) {
+        return false;
+    }
+
+    string names;
+    uint_fast32_t blocked;
+    size_t n;
+    lock_guard<std::mutex> lock(access);
+    while(file >> names >> blocked >> n) {
+        insert(canonical(names, blocked), n);
+    }
+    return true;
+}
+
+void ResultCache::save(const string& fileName) const {
+    ofstream file(fileName, ios::trunc);
+
+    lock_guard<std::mutex> lock(access);
+    for(auto it = entries.rbegin(); it != entries.rend(); ++it) {
+        file << it->first.first << " " << it->first.second << " " << it->second << "\n";
+    }
+
+    file.close();
+    if(!file) {
+        throw runtime_error("ResultCache : ecriture impossible de " + fileName);
+    }
+}
@@ -0,0 +1,93 @@
+/*
+ -----------------------------------------------------------------------------------
+ Laboratoire : ASD1 Cube magique
+ Fichier     : result_cache.h
+ Auteur(s)   : Jorge-André Fulgencio Esteves <jorgeand.fulgencioesteves@heig-vd.ch>,
+               Florian Schaufelberger <florian.schaufelberger@heig-vd.ch>,
+               Jonathan Zaehringer <jonathan.zaehringer@heig-vd.ch>
+
+ Date        : 27.03.2018
+
+ Compilateur : Apple LLVM version 9.0.0 (clang-900.0.39.2)
+               gcc version 5.4.0 20160609 (Ubuntu 5.4.0-6ubuntu1~16.04.9)
+               gcc version 7.2.0 (Debian 7.2.0-19)
+ -----------------------------------------------------------------------------------
+*/
+#ifndef RESULT_CACHE_H
+#define RESULT_CACHE_H
+
+#include <string>
+#include <list>
+#include <unordered_map>
+#include <utility>
+#include <mutex>
+#include <cstdint>
+
+/**
+ * Cache LRU du nombre de solutions d'une instance (pieces, cases occupees).
+ *
+ * Les instances sont ramenees a une forme canonique : pieces triees et
+ * cases occupees minimales sur les symetries du cube (rotations et
+ * reflexions) qui laissent invariants les placements de chaque piece. Une
+ * instance deja resolue, ou symetrique d'une instance resolue, est donc
+ * repondue sans recherche.
+ *
+ * Le cache peut etre partage entre threads.
+ */
+class ResultCache {
+public :
+    typedef std::pair<std::string, uint_fast32_t> Key;
+
+private :
+    struct KeyHash {
+        size_t operator () (const Key& key) const;
+    };
+
+    typedef std::list<std::pair<Key, size_t>> Entries;
+
+    size_t capacity;
+    Entries entries;   // de la plus recente a la plus ancienne
+    std::unordered_map<Key, Entries::iterator, KeyHash> index;
+    size_t nbHits;
+    size_t nbMisses;
+    mutable std::mutex access;
+
+    void insert(const Key& key, size_t count);
+
+public :
+    explicit ResultCache(size_t capacity = 1 << 16);
+
+    /**
+     * @brief Nombre de solutions de l'instance, calcule par SolverContext si absent du cache
+     *
+     * @exception std::invalid_argument si une piece est inconnue
+     */
+    size_t count(const std::string& pieceNames, uint_fast32_t blocked);
+
+    size_t size() const;
+    size_t hits() const;
+    size_t misses() const;
+
+    /**
+     * @brief Ajoute les entrees d'un fichier ecrit par save
+     *
+     * @return false si le fichier n'existe pas
+     */
+    bool load(const std::string& fileName);
+
+    /**
+     * @brief Ecrit les entrees, de la plus ancienne a la plus recente
+     *
+     * @exception std::runtime_error si le fichier ne peut pas etre ecrit
+     */
+    void save(const std::string& fileName) const;
+
+    /**
+     * @brief Forme canonique d'une instance
+     *
+     * @exception std::invalid_argument si une piece est inconnue
+     */
+    static Key canonical(const std::string& pieceNames, uint_fast32_t blocked);
+};
+
+#endif
@@ -0,0 +1,83 @@
+/*
+ -----------------------------------------------------------------------------------
+ Laboratoire : ASD1 Cube magique
+ Fichier     : ring_buffer.h
+ Auteur(s)   : Jorge-André Fulgencio Esteves <jorgeand.fulgencioesteves@heig-vd.ch>,
+               Florian Schaufelberger <florian.schaufelberger@heig-vd.ch>,
+               Jonathan Zaehringer <jonathan.zaehringer@heig-vd.ch>
+
+ Date        : 27.03.2018
+
+ Compilateur : Apple LLVM version 9.0.0 (clang-900.0.39.2)
+               gcc version 5.4.0 20160609 (Ubuntu 5.4.0-6ubuntu1~16.04.9)
+               gcc version 7.2.0 (Debian 7.2.0-19)
+ -----------------------------------------------------------------------------------
+*/
+#ifndef RING_BUFFER_H
+#define RING_BUFFER_H
+
+#include <vector>
+#include <atomic>
+#include <cstddef>
+
+/**
+ * File circulaire bornee sans verrou, pour un seul producteur et un seul
+ * consommateur.
+ */
+template <typename T>
+class RingBuffer {
+private :
+    std::vector<T> slots;
+    size_t mask;
+    alignas(64) std::atomic<size_t> head;   // prochaine case a lire
+    alignas(64) std::atomic<size_t> tail;   // prochaine case a ecrire
+
+public :
+    /**
+     * @param[in] capacity capacite minimale, arrondie a la puissance de deux superieure
+     */
+    explicit RingBuffer(size_t capacity) : head(0), tail(0) {
+        size_t size = 1;
+        while(size < capacity) {
+            size <<= 1;
+        }
+        slots.resize(size);
+        mask = size - 1;
+    }
+
+    /**
+     * @brief Ajout par le producteur
+     *
+     * @return false si la file est pleine
+     */
+    bool tryPush(const T& value) {
+        const size_t t = tail.load(std::memory_order_relaxed);
+        if(t - head.load(std::memory_order_acquire) == slots.size()) {
+            return false;
+        }
+        slots[t & mask] = value;
+        tail.store(t + 1, std::memory_order_release);
+        return true;
+    }
+
+    /**
+     * @brief Retrait par le consommateur
+     *
+     * @return false si la file est vide
+     */
+    bool tryPop(T& value) {
+        const size_t h = head.load(std::memory_order_relaxed);
+        if(h == tail.load(std::memory_order_acquire)) {
+            return false;
+        }
+        value = slots[h & mask];
+        head.store(h + 1, std::memory_order_release);
+        return true;
+    }
+
+    bool empty() const {
+        return head.load(std::memory_order_acquire) == tail.load(std::memory_order_acquire);
+    }
+};
+
+#endif
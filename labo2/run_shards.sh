@@ -0,0 +1,35 @@
+#!/bin/sh
+# Lance N processus locaux, un par shard de megaBruteForce, puis fusionne
+# leurs resultats dans allCombinaisons.txt
+#
+# Usage : ./run_shards.sh [N] [executable]
+
+N=${1:-4}
+BIN=${2:-./a.out}
+
+# Fichiers des shards de ce lancement uniquement, dans l'ordre
+FILES=""
+PIDS=""
+i=0
+while [ "$i" -lt "$N" ]; do
+    rm -f "shard_$i.bin"
+    "$BIN" --shard "$i/$N" --output "shard_$i.bin" > "shard_$i.log" &
+    PIDS="$PIDS $!"
+    FILES="$FILES shard_$i.bin"
+    i=$((i + 1))
+done
+
+failed=0
+i=0
+for pid in $PIDS; do
+    if ! wait "$pid"; then
+        echo "run_shards : le shard $i a echoue (voir shard_$i.log)" >&2
+        failed=1
+    fi
+    i=$((i + 1))
+done
+if [ "$failed" -ne 0 ]; then
+    exit 1
+fi
+
+exec "$BIN" --merge $FILES
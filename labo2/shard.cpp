@@ -0,0 +1,173 @@
+/*
+ -----------------------------------------------------------------------------------
+ Laboratoire : ASD1 Cube magique
+ Fichier     : shard.cpp
+ Auteur(s)   : Jorge-André Fulgencio Esteves <jorgeand.fulgencioesteves@heig-vd.ch>,
+               Florian Schaufelberger <florian.schaufelberger@heig-vd.ch>,
+               Jonathan Zaehringer <jonathan.zaehringer@heig-vd.ch>
+
+ Date        : 27.03.2018
+
+ Compilateur : Apple LLVM version 9.0.0 (clang-900.0.39.2)
+               gcc version 5.4.0 20160609 (Ubuntu 5.4.0-6ubuntu1~16.04.9)
+               gcc version 7.2.0 (Debian 7.2.0-19)
+ -----------------------------------------------------------------------------------
+*/
+#include <fstream>
+#include <stdexcept>
+#include <algorithm>
+#include <numeric>
+#include <cstdint>
+#include <ctime>
+
+#include "shard.h"
+#include "checkpoint.h"
+#include "binary_io.h"
+
+using namespace std;
+
+namespace {
+    const FileMagic MAGIC = {'A', 'S', 'D', 'S', 'H', 'R', 'D', '1'};
+
+    // Produit du nombre de placements encore libres pour chaque piece restante
+    double estimateCost(const ArrPieces& allPieces, uint_fast32_t cube) {
+        double cost = 1;
+        for(size_t d = 2; d < allPieces.size(); d++) {
+            const Pieces& pieces = allPieces[allPieces.size() - 1 - d];
+            cost *= double(count_if(pieces.begin(), pieces.end(),
+                                    [cube](const Piece& p) { return (cube & p.getMask()) == 0; }));
+        }
+        return cost;
+    }
+}
+
+vector<WorkUnit> splitSearch(const vector<ArrPieces>& allCombinations) {
+    vector<WorkUnit> units;
+
+    for(size_t c = 0; c < allCombinations.size(); c++) {
+        const ArrPieces& allPieces = allCombinations[c];
+        if(allPieces.size() < 2) {
+            throw runtime_error("splitSearch : une combinaison doit contenir au moins deux pieces");
+        }
+
+        const Pieces& firsts  = allPieces[allPieces.size() - 1];
+        const Pieces& seconds = allPieces[allPieces.size() - 2];
+        for(size_t i = 0; i < firsts.size(); i++) {
+            for(size_t j = 0; j < seconds.size(); j++) {
+                uint_fast32_t cube = firsts[i].getMask();
+                if((cube & seconds[j].getMask()) == 0) {
+                    units.push_back(WorkUnit{c, i, j, estimateCost(allPieces, cube | seconds[j].getMask())});
+                }
+            }
+        }
+    }
+
+    return units;
+}
+
+vector<size_t> assignShard(const vector<WorkUnit>& units, size_t shard, size_t nbShards) {
+    vector<size_t> order(units.size());
+    iota(order.begin(), order.end(), 0);
+    stable_sort(order.begin(), order.end(), [&units](size_t a, size_t b) { return units[a].cost > units[b].cost; });
+
+    vector<double> load(nbShards, 0);
+    vector<size_t> assigned;
+    for(size_t u : order) {
+        size_t target = size_t(min_element(load.begin(), load.end()) - load.begin());
+        load[target] += units[u].cost;
+        if(target == shard) {
+            assigned.push_back(u);
+        }
+    }
+
+    sort(assigned.begin(), assigned.end());
+    return assigned;
+}
+
+void runShard(const vector<ArrPieces>& allCombinations, size_t shard, size_t nbShards, const string& fileName) {
+    if(shard >= nbShards) {
+        throw runtime_error("runShard : shard invalide");
+    }
+
+    vector<WorkUnit> units = splitSearch(allCombinations);
+    vector<size_t> assigned = assignShard(units, shard, nbShards);
+
+    cout << "Shard " << shard << "/" << nbShards << " : " << assigned.size() << " unites sur " << units.size() << endl;
+
+    ofstream file(fileName, ios::binary | ios::trunc);
+    writeMagic(file, MAGIC);
+    writeBinary<uint64_t>(file, shard);
+    writeBinary<uint64_t>(file, nbShards);
+    writeBinary<uint64_t>(file, units.size());
+    writeBinary<uint64_t>(file, assigned.size());
+
+    auto now = time(nullptr);
+    size_t found = 0;
+    for(size_t u : assigned) {
+        const WorkUnit& unit = units[u];
+        const ArrPieces& allPieces = allCombinations[unit.combination];
+        Puzzles solutions;
+        Puzzle puzzle;
+
+        puzzle.tryToInsert(allPieces[allPieces.size() - 1][unit.first]);
+        puzzle.tryToInsert(allPieces[allPieces.size() - 2][unit.second]);
+        bruteForceMagicCube(allPieces, solutions, puzzle, allPieces.size() - 2);
+
+        found += solutions.size();
+        writeBinary<uint64_t>(file, u);
+        writePuzzles(file, solutions);
+    }
+
+    file.close();
+    if(!file) {
+        throw runtime_error("runShard : ecriture impossible de " + fileName);
+    }
+    cout << endl << "Fini en " << time(nullptr) - now << "[s] (trouver : " << found << ")" << endl;
+}
+
+void mergeShards(const vector<ArrPieces>& allCombinations, const vector<string>& fileNames, Puzzles& solutions) {
+    vector<WorkUnit> units = splitSearch(allCombinations);
+    vector<Puzzles> unitSolutions(units.size());
+    vector<bool> unitDone(units.size(), false);
+    vector<bool> shardDone(fileNames.size(), false);
+
+    for(const string& fileName : fileNames) {
+        ifstream file(fileName, ios::binary);
+        if(!readMagic(file, MAGIC)) {
+            throw runtime_error("mergeShards : " + fileName + " n'est pas un fichier de shard");
+        }
+
+        size_t shard    = size_t(readBinary<uint64_t>(file));
+        size_t nbShards = size_t(readBinary<uint64_t>(file));
+        size_t nbUnits  = size_t(readBinary<uint64_t>(file));
+        size_t nbDone   = size_t(readBinary<uint64_t>(file));
+        if(nbShards != fileNames.size() || shard >= nbShards || shardDone[shard] || nbUnits != units.size()) {
+            throw runtime_error("mergeShards : " + fileName + " ne correspond pas au decoupage");
+        }
+        shardDone[shard] = true;
+
+        for(size_t i = 0; i < nbDone; i++) {
+            size_t u = size_t(readBinary<uint64_t>(file));
+            if(u >= units.size() || unitDone[u]) {
+                throw runtime_error("mergeShards : unite invalide dans " + fileName);
+            }
+            unitDone[u] = true;
+            readPuzzles(file, unitSolutions[u]);
+        }
+    }
+
+    if(find(unitDone.begin(), unitDone.end(), false) != unitDone.end()) {
+        throw runtime_error("mergeShards : des unites de travail manquent");
+    }
+
+    size_t u = 0;
+    for(size_t c = 0; c < allCombinations.size(); c++) {
+        Puzzles combinationSolutions;
+        for(; u < units.size() && units[u].combination == c; u++) {
+            combinationSolutions.insert(combinationSolutions.end(), unitSolutions[u].begin(), unitSolutions[u].end());
+        }
+
+        removeSolutionByPermutation(combinationSolutions);
+        appendCombinationSolutions(combinationSolutions, solutions);
+    }
+}
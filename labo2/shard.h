@@ -0,0 +1,73 @@
+/*
+ -----------------------------------------------------------------------------------
+ Laboratoire : ASD1 Cube magique
+ Fichier     : shard.h
+ Auteur(s)   : Jorge-André Fulgencio Esteves <jorgeand.fulgencioesteves@heig-vd.ch>,
+               Florian Schaufelberger <florian.schaufelberger@heig-vd.ch>,
+               Jonathan Zaehringer <jonathan.zaehringer@heig-vd.ch>
+
+ Date        : 27.03.2018
+
+ Compilateur : Apple LLVM version 9.0.0 (clang-900.0.39.2)
+               gcc version 5.4.0 20160609 (Ubuntu 5.4.0-6ubuntu1~16.04.9)
+               gcc version 7.2.0 (Debian 7.2.0-19)
+ -----------------------------------------------------------------------------------
+*/
+#ifndef SHARD_H
+#define SHARD_H
+
+#include <vector>
+#include <string>
+
+#include "magic_cube.h"
+
+/**
+ * Unite de travail de megaBruteForce : une combinaison dont les deux
+ * premieres pieces posees sont fixees.
+ */
+struct WorkUnit {
+    size_t combination;  // indice de la combinaison
+    size_t first;        // placement de la premiere piece posee
+    size_t second;       // placement de la deuxieme piece posee
+    double cost;         // estimation de la taille du sous-arbre
+};
+
+/**
+ * @brief Decoupe l'espace de recherche en unites de travail
+ *
+ * Les unites sont produites dans l'ordre de parcours de bruteForceMagicCube,
+ * leur concatenation redonne donc exactement l'ordre des solutions d'une
+ * execution sur un seul processus.
+ */
+std::vector<WorkUnit> splitSearch(const std::vector<ArrPieces>& allCombinations);
+
+/**
+ * @brief Indices des unites attribuees au shard (LPT : la plus couteuse va au
+ *        shard le moins charge), dans l'ordre de parcours
+ *
+ * L'attribution ne depend que des unites, tous les processus la calculent
+ * donc a l'identique sans communiquer.
+ */
+std::vector<size_t> assignShard(const std::vector<WorkUnit>& units, size_t shard, size_t nbShards);
+
+/**
+ * @brief Resout les unites d'un shard et ecrit ses solutions dans un fichier binaire
+ *
+ * @exception std::runtime_error si le fichier ne peut pas etre ecrit
+ */
+void runShard(const std::vector<ArrPieces>& allCombinations, size_t shard, size_t nbShards,
+              const std::string& fileName);
+
+/**
+ * @brief Fusionne les fichiers de tous les shards
+ *
+ * Produit les memes solutions que megaBruteForce (sans doublons, un Puzzle
+ * vide separant chaque combinaison).
+ *
+ * @exception std::runtime_error si un shard manque, est en double ou ne
+ *            correspond pas au decoupage
+ */
+void mergeShards(const std::vector<ArrPieces>& allCombinations, const std::vector<std::string>& fileNames,
+                 Puzzles& solutions);
+
+#endif
@@ -0,0 +1,285 @@
+/*
+ -----------------------------------------------------------------------------------
+ Laboratoire : ASD1 Cube magique
+ Fichier     : solution_diagram.cpp
+ Auteur(s)   : Jorge-André Fulgencio Esteves <jorgeand.fulgencioesteves@heig-vd.ch>,
+               Florian Schaufelberger <florian.schaufelberger@heig-vd.ch>,
+               Jonathan Zaehringer <jonathan.zaehringer@heig-vd.ch>
+
+ Date        : 27.03.2018
+
+ Compilateur : Apple LLVM version 9.0.0 (clang-900.0.39.2)
+               gcc version 5.4.0 20160609 (Ubuntu 5.4.0-6ubuntu1~16.04.9)
+               gcc version 7.2.0 (Debian 7.2.0-19)
+ -----------------------------------------------------------------------------------
+*/
+#include <fstream>
+#include <stdexcept>
+#include <algorithm>
+
+#include "solution_diagram.h"
+#include "binary_io.h"
+
+using namespace std;
+
+namespace {
+    const FileMagic MAGIC = {'A', 'S', 'D', 'Z', 'D', 'D', '0', '1'};
+}
+
+const SolutionDiagram::NodeId SolutionDiagram::EMPTY;
+const SolutionDiagram::NodeId SolutionDiagram::BASE;
+
+size_t SolutionDiagram::NodeHash::operator () (const Node& n) const {
+    return (size_t(n.var) * 0x9E3779B97F4A7C15ull) ^ (size_t(n.lo) << 21) ^ size_t(n.hi);
+}
+
+bool SolutionDiagram::NodeEqual::operator () (const Node& a, const Node& b) const {
+    return a.var == b.var && a.lo == b.lo && a.hi == b.hi;
+}
+
+SolutionDiagram::SolutionDiagram() : root(EMPTY) {
+    // Terminaux : variable fictive au-dela de toutes les autres
+    nodes.push_back(Node{UINT32_MAX, EMPTY, EMPTY});
+    nodes.push_back(Node{UINT32_MAX, BASE, BASE});
+}
+
+SolutionDiagram::SolutionDiagram(const SolverContext& context) : SolutionDiagram() {
+    const vector<vector<uint_fast32_t>>& placements = context.getPlacements();
+    pieceNames = context.getPieceNames();
+
+    // Les pieces posees en premier recoivent les plus petites variables
+    vector<Var> firstVar(placements.size());
+    for(size_t piece = placements.size(); piece-- > 0;) {
+        firstVar[piece] = Var(varMask.size());
+        for(uint_fast32_t m : placements[piece]) {
+            varMask.push_back(m);
+            varPiece.push_back(unsigned(piece));
+        }
+    }
+
+    unordered_map<uint64_t, NodeId> memo;
+    root = build(context, firstVar, placements.size(), context.getBlocked(), memo);
+}
+
+SolutionDiagram::NodeId SolutionDiagram::makeNode(Var var, NodeId lo, NodeId hi) {
+    if(hi == EMPTY) {
+        return lo;
+    }
+
+    Node node{var, lo, hi};
+    auto it = unique.find(node);
+    if(it != unique.end()) {
+        return it->second;
+    }
+
+    NodeId id = NodeId(nodes.size());
+    nodes.push_back(node);
+    unique.emplace(node, id);
+    return id;
+}
+
+SolutionDiagram::NodeId SolutionDiagram::build(const SolverContext& context, vector<Var>& firstVar, size_t index,
+                                               uint_fast32_t cube, unordered_map<uint64_t, NodeId>& memo) {
+    if(index == 0) {
+        return BASE;
+    }
+
+    const uint64_t key = (uint64_t(index) << 32) | cube;
+    auto it = memo.find(key);
+    if(it != memo.end()) {
+        return it->second;
+    }
+
+    // Chaine des placements de la piece, du dernier au premier
+    const vector<uint_fast32_t>& placements = context.getPlacements()[index - 1];
+    NodeId f = EMPTY;
+    for(size_t i = placements.size(); i-- > 0;) {
+        if((cube & placements[i]) == 0) {
+            NodeId hi = build(context, firstVar, index - 1, cube | placements[i], memo);
+            f = makeNode(firstVar[index - 1] + Var(i), f, hi);
+        }
+    }
+
+    memo.emplace(key, f);
+    return f;
+}
+
+SolutionDiagram::NodeId SolutionDiagram::getRoot() const {
+    return root;
+}
+
+size_t SolutionDiagram::size() const {
+    return nodes.size();
+}
+
+size_t SolutionDiagram::nbVars() const {
+    return varMask.size();
+}
+
+SolutionDiagram::Var SolutionDiagram::varOf(unsigned piece, uint_fast32_t mask) const {
+    for(Var v = 0; v < varMask.size(); v++) {
+        if(varPiece[v] == piece && varMask[v] == mask) {
+            return v;
+        }
+    }
+    throw out_of_range("SolutionDiagram::varOf");
+}
+
+uint64_t SolutionDiagram::count(NodeId f) const {
+    // Les enfants ont toujours un identifiant plus petit que leur parent
+    for(size_t n = counts.size(); n < nodes.size(); n++) {
+        counts.push_back(n == EMPTY ? 0 : n == BASE ? 1 : counts[nodes[n].lo] + counts[nodes[n].hi]);
+    }
+    return counts[f];
+}
+
+SolutionDiagram::NodeId SolutionDiagram::containing(NodeId f, Var v) {
+    unordered_map<NodeId, NodeId> memo;
+    return filter(f, v, true, memo);
+}
+
+SolutionDiagram::NodeId SolutionDiagram::excluding(NodeId f, Var v) {
+    unordered_map<NodeId, NodeId> memo;
+    return filter(f, v, false, memo);
+}
+
+SolutionDiagram::NodeId SolutionDiagram::filter(NodeId f, Var v, bool containing, unordered_map<NodeId, NodeId>& memo) {
+    if(nodes[f].var > v) {
+        return containing ? EMPTY : f;
+    }
+    if(nodes[f].var == v) {
+        return containing ? makeNode(v, EMPTY, nodes[f].hi) : nodes[f].lo;
+    }
+
+    auto it = memo.find(f);
+    if(it != memo.end()) {
+        return it->second;
+    }
+
+    const Node node = nodes[f];
+    NodeId lo = filter(node.lo, v, containing, memo);
+    NodeId hi = filter(node.hi, v, containing, memo);
+    NodeId result = makeNode(node.var, lo, hi);
+
+    memo.emplace(f, result);
+    return result;
+}
+
+vector<SolutionDiagram::Var> SolutionDiagram::sample(NodeId f, mt19937_64& rng) const {
+    vector<Var> solution;
+
+    if(count(f) == 0) {
+        throw invalid_argument("SolutionDiagram::sample : famille vide");
+    }
+    while(f != BASE) {
+        const Node& node = nodes[f];
+        if(uniform_int_distribution<uint64_t>(0, counts[f] - 1)(rng) < counts[node.hi]) {
+            solution.push_back(node.var);
+            f = node.hi;
+        } else {
+            f = node.lo;
+        }
+    }
+
+    return solution;
+}
+
+void SolutionDiagram::enumerate(NodeId f, const function<void(const vector<Var>&)>& visitor) const {
+    vector<Var> current;
+    enumerate(f, current, visitor);
+}
+
+void SolutionDiagram::enumerate(NodeId f, vector<Var>& current, const function<void(const vector<Var>&)>& visitor) const {
+    if(f == EMPTY) {
+        return;
+    }
+    if(f == BASE) {
+        visitor(current);
+        return;
+    }
+
+    current.push_back(nodes[f].var);
+    enumerate(nodes[f].hi, current, visitor);
+    current.pop_back();
+    enumerate(nodes[f].lo, current, visitor);
+}
+
+Puzzle SolutionDiagram::toPuzzle(const vector<Var>& solution) const {
+    Puzzle puzzle;
+    for(Var v : solution) {
+        puzzle.tryToInsert(Piece(toShape(varMask[v]), varMask[v], varPiece[v], pieceNames[varPiece[v]]));
+    }
+    return puzzle;
+}
+
+void SolutionDiagram::save(const string& fileName) const {
+    ofstream file(fileName, ios::binary | ios::trunc);
+
+    writeMagic(file, MAGIC);
+    writeBinary<uint32_t>(file, uint32_t(pieceNames.size()));
+    file.write(pieceNames.data(), streamsize(pieceNames.size()));
+    writeBinary<uint32_t>(file, uint32_t(varMask.size()));
+    for(size_t v = 0; v < varMask.size(); v++) {
+        writeBinary<uint32_t>(file, uint32_t(varMask[v]));
+        writeBinary<uint8_t>(file, uint8_t(varPiece[v]));
+    }
+    writeBinary<uint32_t>(file, uint32_t(nodes.size()));
+    for(size_t n = 2; n < nodes.size(); n++) {
+        writeBinary<uint32_t>(file, nodes[n].var);
+        writeBinary<uint32_t>(file, nodes[n].lo);
+        writeBinary<uint32_t>(file, nodes[n].hi);
+    }
+    writeBinary<uint32_t>(file, root);
+
+    file.close();
+    if(!file) {
+        throw runtime_error("SolutionDiagram : ecriture impossible de " + fileName);
+    }
+}
+
+SolutionDiagram SolutionDiagram::load(const string& fileName) {
+    ifstream file(fileName, ios::binary);
+    if(!readMagic(file, MAGIC)) {
+        throw runtime_error("SolutionDiagram : " + fileName + " n'est pas un diagramme valide");
+    }
+
+    SolutionDiagram diagram;
+    const uint32_t nbPieces = readBinary<uint32_t>(file);
+    if(nbPieces > UINT8_MAX + 1) {
+        throw runtime_error("SolutionDiagram : nombre de pieces invalide dans " + fileName);
+    }
+    diagram.pieceNames.resize(nbPieces);
+    readBinary(file, &diagram.pieceNames[0], diagram.pieceNames.size());
+
+    // Une variable a la fois : un nombre corrompu bute sur la fin du flux au lieu d'allouer d'avance
+    for(uint32_t v = readBinary<uint32_t>(file); v != 0; v--) {
+        const uint_fast32_t mask = readBinary<uint32_t>(file);
+        const unsigned piece = readBinary<uint8_t>(file);
+        if(mask == 0 || mask >> 27 != 0 || piece >= diagram.pieceNames.size()) {
+            throw runtime_error("SolutionDiagram : placement invalide dans " + fileName);
+        }
+        diagram.varMask.push_back(mask);
+        diagram.varPiece.push_back(piece);
+    }
+
+    // Les enfants precedent leur parent et portent une variable plus grande (terminaux compris)
+    uint32_t nbNodes = readBinary<uint32_t>(file);
+    for(uint32_t n = 2; n < nbNodes; n++) {
+        Node node;
+        node.var = readBinary<uint32_t>(file);
+        node.lo = readBinary<uint32_t>(file);
+        node.hi = readBinary<uint32_t>(file);
+        if(node.lo >= n || node.hi >= n || node.var >= diagram.varMask.size()
+           || diagram.nodes[node.lo].var <= node.var || diagram.nodes[node.hi].var <= node.var) {
+            throw runtime_error("SolutionDiagram : noeud invalide dans " + fileName);
+        }
+        diagram.unique.emplace(node, NodeId(diagram.nodes.size()));
+        diagram.nodes.push_back(node);
+    }
+    diagram.root = readBinary<uint32_t>(file);
+    if(diagram.root >= diagram.nodes.size()) {
+        throw runtime_error("SolutionDiagram : racine invalide dans " + fileName);
+    }
+
+    return diagram;
+}
@@ -0,0 +1,135 @@
+/*
+ -----------------------------------------------------------------------------------
+ Laboratoire : ASD1 Cube magique
+ Fichier     : solution_diagram.h
+ Auteur(s)   : Jorge-André Fulgencio Esteves <jorgeand.fulgencioesteves@heig-vd.ch>,
+               Florian Schaufelberger <florian.schaufelberger@heig-vd.ch>,
+               Jonathan Zaehringer <jonathan.zaehringer@heig-vd.ch>
+
+ Date        : 27.03.2018
+
+ Compilateur : Apple LLVM version 9.0.0 (clang-900.0.39.2)
+               gcc version 5.4.0 20160609 (Ubuntu 5.4.0-6ubuntu1~16.04.9)
+               gcc version 7.2.0 (Debian 7.2.0-19)
+ -----------------------------------------------------------------------------------
+*/
+#ifndef SOLUTION_DIAGRAM_H
+#define SOLUTION_DIAGRAM_H
+
+#include <vector>
+#include <string>
+#include <random>
+#include <functional>
+#include <unordered_map>
+#include <cstdint>
+
+#include "puzzle.h"
+#include "solver_context.h"
+
+/**
+ * Famille des solutions d'une instance sous forme de diagramme de decision
+ * a suppression de zeros (ZDD) sur les variables de placement.
+ *
+ * Une variable correspond a un placement d'une piece. Les variables des
+ * pieces posees en premier (la derniere piece de l'instance) sont en haut
+ * du diagramme. Les sous-problemes identiques (meme piece, meme occupation)
+ * sont partages, le diagramme reste donc bien plus petit que Puzzles.
+ */
+class SolutionDiagram {
+public :
+    typedef uint32_t NodeId;
+    typedef uint32_t Var;
+
+    static const NodeId EMPTY = 0;   // famille vide
+    static const NodeId BASE  = 1;   // famille contenant l'ensemble vide
+
+private :
+    struct Node {
+        Var var;
+        NodeId lo;   // solutions sans var
+        NodeId hi;   // solutions avec var (var retiree)
+    };
+
+    struct NodeHash {
+        size_t operator () (const Node& n) const;
+    };
+
+    struct NodeEqual {
+        bool operator () (const Node& a, const Node& b) const;
+    };
+
+    std::string pieceNames;
+    std::vector<uint_fast32_t> varMask;    // placement de chaque variable
+    std::vector<unsigned> varPiece;        // piece (indice dans pieceNames) de chaque variable
+    std::vector<Node> nodes;
+    std::unordered_map<Node, NodeId, NodeHash, NodeEqual> unique;
+    mutable std::vector<uint64_t> counts;
+    NodeId root;
+
+    NodeId makeNode(Var var, NodeId lo, NodeId hi);
+    NodeId build(const SolverContext& context, std::vector<Var>& firstVar, size_t index, uint_fast32_t cube,
+                 std::unordered_map<uint64_t, NodeId>& memo);
+    NodeId filter(NodeId f, Var v, bool containing, std::unordered_map<NodeId, NodeId>& memo);
+    void enumerate(NodeId f, std::vector<Var>& current, const std::function<void(const std::vector<Var>&)>& visitor) const;
+
+    SolutionDiagram();
+
+public :
+    /**
+     * @brief Construit le diagramme par une recherche en profondeur memoisee
+     */
+    explicit SolutionDiagram(const SolverContext& context);
+
+    NodeId getRoot() const;
+
+    /**
+     * @brief Nombre de noeuds (terminaux compris)
+     */
+    size_t size() const;
+
+    size_t nbVars() const;
+
+    /**
+     * @brief Variable du placement d'une piece
+     *
+     * @exception std::out_of_range si la piece ne peut pas occuper ce placement
+     */
+    Var varOf(unsigned piece, uint_fast32_t mask) const;
+
+    /**
+     * @brief Nombre exact de solutions de la famille f
+     */
+    uint64_t count(NodeId f) const;
+
+    /**
+     * @brief Solutions de f contenant (ou excluant) le placement v
+     */
+    NodeId containing(NodeId f, Var v);
+    NodeId excluding(NodeId f, Var v);
+
+    /**
+     * @brief Tirage uniforme d'une solution de f
+     *
+     * @exception std::invalid_argument si f est vide
+     */
+    std::vector<Var> sample(NodeId f, std::mt19937_64& rng) const;
+
+    /**
+     * @brief Appelle visitor avec chaque solution de f, a la demande
+     */
+    void enumerate(NodeId f, const std::function<void(const std::vector<Var>&)>& visitor) const;
+
+    Puzzle toPuzzle(const std::vector<Var>& solution) const;
+
+    /**
+     * @exception std::runtime_error si le fichier ne peut pas etre ecrit
+     */
+    void save(const std::string& fileName) const;
+
+    /**
+     * @exception std::runtime_error si le fichier est absent ou invalide
+     */
+    static SolutionDiagram load(const std::string& fileName);
+};
+
+#endif
@@ -0,0 +1,309 @@
+/*
+ -----------------------------------------------------------------------------------
+ Laboratoire : ASD1 Cube magique
+ Fichier     : solution_index.cpp
+ Auteur(s)   : Jorge-André Fulgencio Esteves <jorgeand.fulgencioesteves@heig-vd.ch>,
+               Florian Schaufelberger <florian.schaufelberger@heig-vd.ch>,
+               Jonathan Zaehringer <jonathan.zaehringer@heig-vd.ch>
+
+ Date        : 27.03.2018
+
+ Compilateur : Apple LLVM version 9.0.0 (clang-900.0.39.2)
+               gcc version 5.4.0 20160609 (Ubuntu 5.4.0-6ubuntu1~16.04.9)
+               gcc version 7.2.0 (Debian 7.2.0-19)
+ -----------------------------------------------------------------------------------
+*/
+#include <fstream>
+#include <sstream>
+#include <stdexcept>
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+#include <cctype>
+#include <iterator>
+
+#include <unistd.h>
+#include <sys/socket.h>
+#include <sys/stat.h>
+#include <sys/un.h>
+
+#include "solution_index.h"
+#include "checkpoint.h"
+#include "binary_io.h"
+
+using namespace std;
+
+namespace {
+    const FileMagic MAGIC = {'A', 'S', 'D', 'I', 'D', 'X', '0', '1'};
+
+    // Coordonnee d'un terme : un chiffre de 0 a 2, ou -1 pour '*'
+    int coordinate(const string& term, size_t i) {
+        if(i >= term.size()) {
+            throw invalid_argument("terme invalide : " + term);
+        }
+        if(term[i] == '*') {
+            return -1;
+        }
+        if(term[i] < '0' || term[i] > '2') {
+            throw invalid_argument("terme invalide : " + term);
+        }
+        return term[i] - '0';
+    }
+}
+
+SolutionIndex::SolutionIndex() : nbWords(0) {
+}
+
+SolutionIndex::SolutionIndex(const Puzzles& solutions) : solutions(solutions), nbWords(0) {
+    build();
+}
+
+void SolutionIndex::build() {
+    names.clear();
+    for(const Puzzle& puzzle : solutions) {
+        for(const Piece& p : puzzle.getPieces()) {
+            if(names.find(p.getName()) == string::npos) {
+                names += p.getName();
+            }
+        }
+    }
+
+    nbWords = (solutions.size() + 63) / 64;
+    bitmaps.assign(names.size() * 27 * nbWords, 0);
+    for(size_t s = 0; s < solutions.size(); s++) {
+        for(const Piece& p : solutions[s].getPieces()) {
+            const size_t name = names.find(p.getName());
+            for(size_t cell = 0; cell < 27; cell++) {
+                if(p.getMask() & (uint_fast32_t(1) << cell)) {
+                    bitmaps[(name * 27 + cell) * nbWords + s / 64] |= uint64_t(1) << (s % 64);
+                }
+            }
+        }
+    }
+}
+
+const uint64_t* SolutionIndex::bitmap(size_t name, size_t cell) const {
+    return &bitmaps[(name * 27 + cell) * nbWords];
+}
+
+size_t SolutionIndex::size() const {
+    return solutions.size();
+}
+
+const Puzzle& SolutionIndex::at(size_t solution) const {
+    return solutions.at(solution);
+}
+
+SolutionIndex::Selection SolutionIndex::all() const {
+    Selection selection(nbWords, ~uint64_t(0));
+    if(solutions.size() % 64 != 0) {
+        selection.back() = (uint64_t(1) << (solutions.size() % 64)) - 1;
+    }
+    return selection;
+}
+
+void SolutionIndex::filter(Selection& selection, const string& term) const {
+    const bool negated = !term.empty() && term[0] == '-';
+    const size_t n = negated ? 1 : 0;
+    if(term.size() != n + 7 || term[n + 1] != '@' || term[n + 3] != ',' || term[n + 5] != ',') {
+        throw invalid_argument("terme invalide : " + term);
+    }
+    const int x = coordinate(term, n + 2), y = coordinate(term, n + 4), z = coordinate(term, n + 6);
+
+    // Union des cases designees ; un nom absent de l'index n'occupe aucune case
+    Selection matching(nbWords, 0);
+    const size_t name = names.find(term[n]);
+    for(size_t cell = 0; cell < 27 && name != string::npos; cell++) {
+        if((x < 0 || int(cell % 3) == x) && (y < 0 || int(cell / 3 % 3) == y) && (z < 0 || int(cell / 9) == z)) {
+            const uint64_t* b = bitmap(name, cell);
+            for(size_t w = 0; w < nbWords; w++) {
+                matching[w] |= b[w];
+            }
+        }
+    }
+
+    for(size_t w = 0; w < nbWords; w++) {
+        selection[w] &= negated ? ~matching[w] : matching[w];
+    }
+}
+
+size_t SolutionIndex::count(const Selection& selection) {
+    size_t n = 0;
+    for(uint64_t word : selection) {
+        n += size_t(__builtin_popcountll(word));
+    }
+    return n;
+}
+
+vector<size_t> SolutionIndex::hits(const Selection& selection, size_t limit) {
+    vector<size_t> result;
+    for(size_t w = 0; w < selection.size() && result.size() < limit; w++) {
+        for(uint64_t bits = selection[w]; bits != 0 && result.size() < limit; bits &= bits - 1) {
+            result.push_back(w * 64 + size_t(__builtin_ctzll(bits)));
+        }
+    }
+    return result;
+}
+
+void SolutionIndex::save(const string& fileName) const {
+    ofstream file(fileName, ios::binary | ios::trunc);
+
+    writeMagic(file, MAGIC);
+    writePuzzles(file, solutions);
+    writeBinary<uint32_t>(file, uint32_t(names.size()));
+    file.write(names.data(), streamsize(names.size()));
+    for(uint64_t word : bitmaps) {
+        writeBinary<uint64_t>(file, word);
+    }
+
+    file.close();
+    if(!file) {
+        throw runtime_error("SolutionIndex : ecriture impossible de " + fileName);
+    }
+}
+
+SolutionIndex SolutionIndex::load(const string& fileName) {
+    ifstream file(fileName, ios::binary);
+    if(!readMagic(file, MAGIC)) {
+        throw runtime_error("SolutionIndex : " + fileName + " n'est pas un index valide");
+    }
+
+    SolutionIndex index;
+    readPuzzles(file, index.solutions);
+    index.names.resize(readBinary<uint32_t>(file));
+    readBinary(file, &index.names[0], index.names.size());
+    index.nbWords = (index.solutions.size() + 63) / 64;
+    index.bitmaps.resize(index.names.size() * 27 * index.nbWords);
+    for(uint64_t& word : index.bitmaps) {
+        word = readBinary<uint64_t>(file);
+    }
+
+    return index;
+}
+
+QuerySession::QuerySession(const SolutionIndex& index) : index(index), selection(index.all()) {
+}
+
+bool QuerySession::execute(const string& line, ostream& os) {
+    istringstream words(line);
+    string command;
+    if(!(words >> command)) {
+        return true;
+    }
+    if(command == "quit") {
+        return false;
+    }
+    if(command == "help") {
+        os << "count [termes] | show [n] [termes] | filter termes | reset | quit" << endl
+           << "terme : N@x,y,z (piece N sur la case, '*' pour toute coordonnee), -N@x,y,z pour l'exclure" << endl;
+        return true;
+    }
+    if(command == "reset") {
+        selection = index.all();
+        os << index.size() << " solutions" << endl;
+        return true;
+    }
+
+    const auto start = chrono::steady_clock::now();
+    vector<string> terms{istream_iterator<string>(words), istream_iterator<string>()};
+
+    // Une commande erronee (terme invalide, nombre hors limites) ne met pas fin a la session
+    try {
+        size_t limit = 1;
+        if(command == "show" && !terms.empty() && all_of(terms[0].begin(), terms[0].end(), ::isdigit)) {
+            if(terms[0].size() > 9) {
+                throw out_of_range("show : nombre de solutions trop grand " + terms[0]);
+            }
+            limit = size_t(stoul(terms[0]));
+            terms.erase(terms.begin());
+        }
+
+        SolutionIndex::Selection result(selection);
+        for(const string& term : terms) {
+            index.filter(result, term);
+        }
+
+        if(command == "filter") {
+            selection = result;
+        } else if(command == "show") {
+            for(size_t s : SolutionIndex::hits(result, limit)) {
+                os << "Solution " << s << " :" << endl << index.at(s);
+            }
+        } else if(command != "count") {
+            os << "commande inconnue : " << command << " (help pour l'aide)" << endl;
+            return true;
+        }
+
+        chrono::duration<double, milli> elapsed = chrono::steady_clock::now() - start;
+        os << SolutionIndex::count(result) << " solutions (" << elapsed.count() << " ms)" << endl;
+    } catch(const logic_error& e) {
+        os << e.what() << endl;
+    }
+    return true;
+}
+
+void serveQueries(const SolutionIndex& index, istream& is, ostream& os) {
+    QuerySession session(index);
+    for(string line; getline(is, line);) {
+        if(!session.execute(line, os)) {
+            break;
+        }
+        os << flush;
+    }
+}
+
+void serveQueries(const SolutionIndex& index, const string& socketPath) {
+    sockaddr_un address;
+    memset(&address, 0, sizeof(address));
+    address.sun_family = AF_UNIX;
+    if(socketPath.size() >= sizeof(address.sun_path)) {
+        throw runtime_error("serveQueries : chemin de socket trop long");
+    }
+    strcpy(address.sun_path, socketPath.c_str());
+
+    // Seul un socket laisse par un serveur precedent est remplace, jamais un autre fichier
+    struct stat info;
+    if(lstat(socketPath.c_str(), &info) == 0) {
+        if(!S_ISSOCK(info.st_mode)) {
+            throw runtime_error("serveQueries : " + socketPath + " existe et n'est pas un socket");
+        }
+        unlink(socketPath.c_str());
+    }
+
+    const int server = socket(AF_UNIX, SOCK_STREAM, 0);
+    if(server < 0 || ::bind(server, reinterpret_cast<sockaddr*>(&address), sizeof(address)) != 0 || listen(server, 4) != 0) {
+        if(server >= 0) {
+            close(server);
+        }
+        throw runtime_error("serveQueries : impossible d'ecouter sur " + socketPath);
+    }
+
+    for(int client; (client = accept(server, nullptr, nullptr)) >= 0;) {
+        QuerySession session(index);
+        string pending;
+        char buffer[4096];
+        bool open = true;
+        for(ssize_t n; open && (n = ::read(client, buffer, sizeof(buffer))) > 0;) {
+            pending.append(buffer, size_t(n));
+            for(size_t end; open && (end = pending.find('\n')) != string::npos;) {
+                ostringstream answer;
+                open = session.execute(pending.substr(0, end), answer);
+                pending.erase(0, end + 1);
+
+                const string text = answer.str();
+                for(size_t sent = 0; sent < text.size();) {
+                    const ssize_t k = send(client, text.data() + sent, text.size() - sent, MSG_NOSIGNAL);
+                    if(k <= 0) {
+                        open = false;
+                        break;
+                    }
+                    sent += size_t(k);
+                }
+            }
+        }
+        close(client);
+    }
+
+    close(server);
+    unlink(socketPath.c_str());
+}
@@ -0,0 +1,128 @@
+/*
+ -----------------------------------------------------------------------------------
+ Laboratoire : ASD1 Cube magique
+ Fichier     : solution_index.h
+ Auteur(s)   : Jorge-André Fulgencio Esteves <jorgeand.fulgencioesteves@heig-vd.ch>,
+               Florian Schaufelberger <florian.schaufelberger@heig-vd.ch>,
+               Jonathan Zaehringer <jonathan.zaehringer@heig-vd.ch>
+
+ Date        : 27.03.2018
+
+ Compilateur : Apple LLVM version 9.0.0 (clang-900.0.39.2)
+               gcc version 5.4.0 20160609 (Ubuntu 5.4.0-6ubuntu1~16.04.9)
+               gcc version 7.2.0 (Debian 7.2.0-19)
+ -----------------------------------------------------------------------------------
+*/
+#ifndef SOLUTION_INDEX_H
+#define SOLUTION_INDEX_H
+
+#include <vector>
+#include <string>
+#include <iostream>
+#include <cstdint>
+
+#include "puzzle.h"
+
+/**
+ * Solutions pretes a etre interrogees : la liste des Puzzle et, pour chaque
+ * nom de piece et chaque case, l'ensemble (bitmap) des solutions ou une piece
+ * de ce nom occupe la case. Un filtre n'est donc qu'une suite de ET/OU sur
+ * des mots de 64 bits.
+ */
+class SolutionIndex {
+public :
+    typedef std::vector<uint64_t> Selection;   // un bit par solution
+
+private :
+    Puzzles solutions;
+    std::string names;                           // noms de pieces presents
+    size_t nbWords;
+    std::vector<uint64_t> bitmaps;               // (nom, case) -> solutions
+
+    const uint64_t* bitmap(size_t name, size_t cell) const;
+    void build();
+
+    SolutionIndex();
+
+public :
+    explicit SolutionIndex(const Puzzles& solutions);
+
+    size_t size() const;
+    const Puzzle& at(size_t solution) const;
+
+    /**
+     * @brief Selection de toutes les solutions
+     */
+    Selection all() const;
+
+    /**
+     * @brief Restreint la selection aux solutions verifiant un terme
+     *
+     * Un terme "N@x,y,z" exige qu'une piece N occupe la case (x, y, z), '*'
+     * designant n'importe quelle coordonnee ("T@*,*,2" : un T sur la couche
+     * du dessus). Precede de '-', il exige au contraire qu'aucune piece N
+     * n'y soit.
+     *
+     * @exception std::invalid_argument si le terme est invalide
+     */
+    void filter(Selection& selection, const std::string& term) const;
+
+    static size_t count(const Selection& selection);
+
+    /**
+     * @brief Solutions de la selection, dans l'ordre, au plus limit
+     */
+    static std::vector<size_t> hits(const Selection& selection, size_t limit);
+
+    /**
+     * @exception std::runtime_error si le fichier ne peut pas etre ecrit
+     */
+    void save(const std::string& fileName) const;
+
+    /**
+     * @exception std::runtime_error si le fichier est absent ou invalide
+     */
+    static SolutionIndex load(const std::string& fileName);
+};
+
+/**
+ * Session d'interrogation d'un index, une commande par ligne :
+ *
+ *     count [termes]     nombre de solutions de la selection verifiant les termes
+ *     show [n] [termes]  affiche les n premieres (1 par defaut)
+ *     filter termes      restreint la selection de la session
+ *     reset              revient a toutes les solutions
+ *     help, quit
+ */
+class QuerySession {
+private :
+    const SolutionIndex& index;
+    SolutionIndex::Selection selection;
+
+public :
+    explicit QuerySession(const SolutionIndex& index);
+
+    /**
+     * @brief Execute une commande et ecrit la reponse dans os
+     *
+     * @return false si la session doit se terminer
+     */
+    bool execute(const std::string& line, std::ostream& os);
+};
+
+/**
+ * @brief Repond aux commandes lues sur is jusqu'a quit ou la fin du flux
+ */
+void serveQueries(const SolutionIndex& index, std::istream& is, std::ostream& os);
+
+/**
+ * @brief Repond aux commandes recues sur un socket Unix local
+ *
+ * Les connexions sont servies l'une apres l'autre, chacune avec sa propre
+ * session ; la fonction ne rend la main qu'en cas d'erreur.
+ *
+ * @exception std::runtime_error si le socket ne peut pas etre cree
+ */
+void serveQueries(const SolutionIndex& index, const std::string& socketPath);
+
+#endif
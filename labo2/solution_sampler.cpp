@@ -0,0 +1,108 @@
+/*
+ -----------------------------------------------------------------------------------
+ Laboratoire : ASD1 Cube magique
+ Fichier     : solution_sampler.cpp
+ Auteur(s)   : Jorge-André Fulgencio Esteves <jorgeand.fulgencioesteves@heig-vd.ch>,
+               Florian Schaufelberger <florian.schaufelberger@heig-vd.ch>,
+               Jonathan Zaehringer <jonathan.zaehringer@heig-vd.ch>
+
+ Date        : 27.03.2018
+
+ Compilateur : Apple LLVM version 9.0.0 (clang-900.0.39.2)
+               gcc version 5.4.0 20160609 (Ubuntu 5.4.0-6ubuntu1~16.04.9)
+               gcc version 7.2.0 (Debian 7.2.0-19)
+ -----------------------------------------------------------------------------------
+*/
+#include <algorithm>
+#include <stdexcept>
+
+#include "solution_sampler.h"
+
+using namespace std;
+
+const uint32_t SolutionSampler::NONE;
+
+SolutionSampler::SolutionSampler(const SolverContext& context)
+    : pieceNames(context.getPieceNames()), states{State{0, 0}} {
+    unordered_map<uint64_t, uint32_t> memo;
+    root = build(context, context.getBlocked(), pieceNames.size(), memo);
+}
+
+uint32_t SolutionSampler::build(const SolverContext& context, uint_fast32_t cube, size_t index,
+                                unordered_map<uint64_t, uint32_t>& memo) {
+    if(index == 0) {
+        return 0;   // etat terminal, une solution
+    }
+
+    const uint64_t key = uint64_t(cube) | (uint64_t(index) << 32);
+    auto it = memo.find(key);
+    if(it != memo.end()) {
+        return it->second;
+    }
+
+    vector<pair<uint32_t, uint32_t>> children;   // (etat, placement)
+    for(uint_fast32_t m : context.getPlacements()[index - 1]) {
+        if((cube & m) == 0) {
+            const uint32_t s = build(context, cube | m, index - 1, memo);
+            if(s != NONE) {
+                children.push_back(make_pair(s, uint32_t(m)));
+            }
+        }
+    }
+
+    uint32_t id = NONE;
+    if(!children.empty()) {
+        id = uint32_t(states.size());
+        states.push_back(State{uint32_t(cumulative.size()), uint32_t(children.size())});
+        uint64_t total = 0;
+        for(const auto& c : children) {
+            const State& s = states[c.first];
+            total += s.size == 0 ? 1 : cumulative[s.first + s.size - 1];
+            cumulative.push_back(total);
+            child.push_back(c.first);
+            mask.push_back(c.second);
+        }
+    }
+
+    memo[key] = id;
+    return id;
+}
+
+uint64_t SolutionSampler::count() const {
+    if(root == NONE) {
+        return 0;
+    }
+    const State& s = states[root];
+    return s.size == 0 ? 1 : cumulative[s.first + s.size - 1];
+}
+
+size_t SolutionSampler::size() const {
+    return states.size();
+}
+
+void SolutionSampler::sample(mt19937_64& rng, vector<uint_fast32_t>& placed) const {
+    if(root == NONE) {
+        throw invalid_argument("SolutionSampler::sample : aucune solution");
+    }
+
+    placed.resize(pieceNames.size());
+    uint32_t s = root;
+    for(size_t index = pieceNames.size(); index > 0; index--) {
+        const State& state = states[s];
+        const auto first = cumulative.begin() + state.first;
+        const auto last = first + state.size;
+        const uint64_t r = uniform_int_distribution<uint64_t>(0, *(last - 1) - 1)(rng);
+        const size_t k = size_t(upper_bound(first, last, r) - cumulative.begin());
+
+        placed[index - 1] = mask[k];
+        s = child[k];
+    }
+}
+
+Puzzle SolutionSampler::toPuzzle(const vector<uint_fast32_t>& placed) const {
+    Puzzle puzzle;
+    for(size_t i = placed.size(); i-- > 0;) {
+        puzzle.tryToInsert(Piece(toShape(placed[i]), placed[i], unsigned(i), pieceNames[i]));
+    }
+    return puzzle;
+}
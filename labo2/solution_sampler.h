@@ -0,0 +1,85 @@
+/*
+ -----------------------------------------------------------------------------------
+ Laboratoire : ASD1 Cube magique
+ Fichier     : solution_sampler.h
+ Auteur(s)   : Jorge-André Fulgencio Esteves <jorgeand.fulgencioesteves@heig-vd.ch>,
+               Florian Schaufelberger <florian.schaufelberger@heig-vd.ch>,
+               Jonathan Zaehringer <jonathan.zaehringer@heig-vd.ch>
+
+ Date        : 27.03.2018
+
+ Compilateur : Apple LLVM version 9.0.0 (clang-900.0.39.2)
+               gcc version 5.4.0 20160609 (Ubuntu 5.4.0-6ubuntu1~16.04.9)
+               gcc version 7.2.0 (Debian 7.2.0-19)
+ -----------------------------------------------------------------------------------
+*/
+#ifndef SOLUTION_SAMPLER_H
+#define SOLUTION_SAMPLER_H
+
+#include <vector>
+#include <string>
+#include <random>
+#include <unordered_map>
+#include <cstdint>
+
+#include "puzzle.h"
+#include "solver_context.h"
+
+/**
+ * Tirage uniforme de solutions sans les enumerer.
+ *
+ * Un premier parcours memoise compte les solutions de chaque etat (cases
+ * occupees, pieces restantes). Pour chaque etat ne sont gardes que ses
+ * placements menant a au moins une solution, avec le cumul de leurs comptes :
+ * un tirage descend ensuite de la racine en choisissant chaque placement
+ * proportionnellement a son compte (une recherche dichotomique par piece).
+ *
+ * Les solutions tirees sont uniformes parmi toutes les solutions, donc aussi
+ * parmi les solutions sans permutation des pieces semblables (chacune en
+ * represente le meme nombre).
+ */
+class SolutionSampler {
+private :
+    static const uint32_t NONE = UINT32_MAX;
+
+    struct State {
+        uint32_t first;   // premier placement de l'etat dans cumulative, child et mask
+        uint32_t size;
+    };
+
+    std::string pieceNames;
+    std::vector<State> states;
+    std::vector<uint64_t> cumulative;   // solutions des placements jusqu'a celui-ci compris
+    std::vector<uint32_t> child;        // etat atteint par chaque placement
+    std::vector<uint32_t> mask;
+    uint32_t root;
+
+    uint32_t build(const SolverContext& context, uint_fast32_t cube, size_t index,
+                   std::unordered_map<uint64_t, uint32_t>& memo);
+
+public :
+    explicit SolutionSampler(const SolverContext& context);
+
+    /**
+     * @brief Nombre exact de solutions (permutations des pieces semblables comprises)
+     */
+    uint64_t count() const;
+
+    /**
+     * @brief Nombre d'etats gardes, pour estimer la memoire utilisee
+     */
+    size_t size() const;
+
+    /**
+     * @brief Tirage uniforme d'une solution
+     *
+     * @param[out] placed placement de chaque piece, dans l'ordre de pieceNames
+     *
+     * @exception std::invalid_argument si l'instance n'a aucune solution
+     */
+    void sample(std::mt19937_64& rng, std::vector<uint_fast32_t>& placed) const;
+
+    Puzzle toPuzzle(const std::vector<uint_fast32_t>& placed) const;
+};
+
+#endif
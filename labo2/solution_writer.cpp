@@ -0,0 +1,145 @@
+/*
+ -----------------------------------------------------------------------------------
+ Laboratoire : ASD1 Cube magique
+ Fichier     : solution_writer.cpp
+ Auteur(s)   : Jorge-André Fulgencio Esteves <jorgeand.fulgencioesteves@heig-vd.ch>,
+               Florian Schaufelberger <florian.schaufelberger@heig-vd.ch>,
+               Jonathan Zaehringer <jonathan.zaehringer@heig-vd.ch>
+
+ Date        : 27.03.2018
+
+ Compilateur : Apple LLVM version 9.0.0 (clang-900.0.39.2)
+               gcc version 5.4.0 20160609 (Ubuntu 5.4.0-6ubuntu1~16.04.9)
+               gcc version 7.2.0 (Debian 7.2.0-19)
+ -----------------------------------------------------------------------------------
+*/
+#include <stdexcept>
+#include <algorithm>
+
+#include "solution_writer.h"
+#include "render.h"
+
+using namespace std;
+
+const size_t PackedSolution::MAX_PIECES;
+
+SolutionWriter::SolutionWriter(const string& fileName, OutputFormat format, Backpressure policy,
+                               size_t ringCapacity, size_t chunkSize)
+    : fileName(fileName), file(fileName, ios::binary | ios::trunc), format(format), policy(policy), chunkSize(chunkSize),
+      ring(ringCapacity), closing(false), nbDropped(0), sleeping(false) {
+    if(!file) {
+        throw runtime_error("SolutionWriter : ouverture impossible de " + fileName);
+    }
+    writer = thread(&SolutionWriter::run, this);
+}
+
+SolutionWriter::~SolutionWriter() {
+    // Un echec d'ecriture ne peut pas sortir d'un destructeur : close() le signale
+    try {
+        close();
+    } catch(const runtime_error&) {
+    }
+}
+
+bool SolutionWriter::write(const Puzzle& puzzle) {
+    PackedSolution solution;
+    const Pieces& pieces = puzzle.getPieces();
+
+    if(pieces.size() > PackedSolution::MAX_PIECES) {
+        throw invalid_argument("SolutionWriter::write : trop de pieces dans la solution");
+    }
+    solution.nbPieces = uint8_t(pieces.size());
+    for(size_t i = 0; i < solution.nbPieces; i++) {
+        solution.ids[i] = uint8_t(pieces[i].getId());
+        solution.names[i] = pieces[i].getName();
+        solution.masks[i] = uint32_t(pieces[i].getMask());
+    }
+
+    while(!ring.tryPush(solution)) {
+        if(policy == Backpressure::DROP) {
+            ++nbDropped;
+            return false;
+        }
+        this_thread::yield();
+    }
+    notifyWriter();
+    return true;
+}
+
+void SolutionWriter::close() {
+    if(writer.joinable()) {
+        closing = true;
+        notifyWriter();
+        writer.join();
+        file.close();
+        if(!file) {
+            throw runtime_error("SolutionWriter : ecriture impossible de " + fileName);
+        }
+    }
+}
+
+void SolutionWriter::notifyWriter() {
+    // Le verrou n'est pris que si le thread d'ecriture dort : l'ajout dans la
+    // file reste sans verrou tant que celui-ci suit le rythme
+    atomic_thread_fence(memory_order_seq_cst);
+    if(sleeping.load(memory_order_relaxed)) {
+        lock_guard<std::mutex> lock(mutex);
+        wakeUp.notify_one();
+    }
+}
+
+size_t SolutionWriter::dropped() const {
+    return nbDropped;
+}
+
+void SolutionWriter::run() {
+    string buffer;
+    buffer.reserve(chunkSize + 256);
+
+    for(;;) {
+        PackedSolution solution;
+        if(ring.tryPop(solution)) {
+            formatSolution(solution, buffer);
+            if(buffer.size() >= chunkSize) {
+                file.write(buffer.data(), streamsize(buffer.size()));
+                buffer.clear();
+            }
+        } else if(closing) {
+            // closing est lu apres une file vide : plus rien ne peut arriver
+            if(ring.empty()) {
+                break;
+            }
+        } else {
+            // File vide : attente d'un ajout ou de close(). sleeping est publie
+            // avant de relire la file, et notifyWriter ajoute avant de lire
+            // sleeping : l'un des deux voit forcement l'autre
+            unique_lock<std::mutex> lock(mutex);
+            sleeping.store(true, memory_order_relaxed);
+            atomic_thread_fence(memory_order_seq_cst);
+            if(ring.empty() && !closing) {
+                wakeUp.wait(lock);
+            }
+            sleeping.store(false, memory_order_relaxed);
+        }
+    }
+
+    file.write(buffer.data(), streamsize(buffer.size()));
+}
+
+void SolutionWriter::formatSolution(const PackedSolution& solution, string& buffer) const {
+    if(format == OutputFormat::BINARY) {
+        buffer.push_back(char(solution.nbPieces));
+        for(size_t i = 0; i < solution.nbPieces; i++) {
+            buffer.append(reinterpret_cast<const char*>(&solution.masks[i]), sizeof(uint32_t));
+            buffer.push_back(char(solution.ids[i]));
+            buffer.push_back(solution.names[i]);
+        }
+        return;
+    }
+
+    CellLabels labels = emptyCells();
+    for(size_t i = 0; i < solution.nbPieces; i++) {
+        labelCells(labels, solution.masks[i], solution.ids[i]);
+    }
+    appendForVTK(buffer, labels);
+}
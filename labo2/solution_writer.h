@@ -0,0 +1,112 @@
+/*
+ -----------------------------------------------------------------------------------
+ Laboratoire : ASD1 Cube magique
+ Fichier     : solution_writer.h
+ Auteur(s)   : Jorge-André Fulgencio Esteves <jorgeand.fulgencioesteves@heig-vd.ch>,
+               Florian Schaufelberger <florian.schaufelberger@heig-vd.ch>,
+               Jonathan Zaehringer <jonathan.zaehringer@heig-vd.ch>
+
+ Date        : 27.03.2018
+
+ Compilateur : Apple LLVM version 9.0.0 (clang-900.0.39.2)
+               gcc version 5.4.0 20160609 (Ubuntu 5.4.0-6ubuntu1~16.04.9)
+               gcc version 7.2.0 (Debian 7.2.0-19)
+ -----------------------------------------------------------------------------------
+*/
+#ifndef SOLUTION_WRITER_H
+#define SOLUTION_WRITER_H
+
+#include <string>
+#include <fstream>
+#include <thread>
+#include <atomic>
+#include <mutex>
+#include <condition_variable>
+#include <cstdint>
+
+#include "puzzle.h"
+#include "ring_buffer.h"
+
+/**
+ * Solution reduite aux masques et identifiants de ses pieces
+ */
+struct PackedSolution {
+    static const size_t MAX_PIECES = 9;
+
+    uint8_t nbPieces;
+    uint8_t ids[MAX_PIECES];
+    char names[MAX_PIECES];
+    uint32_t masks[MAX_PIECES];
+};
+
+enum class OutputFormat {
+    TEXT,     // meme format que Puzzle::displayForVTK
+    BINARY    // meme format que writePuzzles, sans l'entete de taille
+};
+
+enum class Backpressure {
+    WAIT,     // le solveur attend qu'une place se libere
+    DROP      // la solution est perdue et comptee dans dropped()
+};
+
+/**
+ * Ecriture asynchrone de solutions dans un fichier.
+ *
+ * Le solveur depose les solutions compactees dans une file sans verrou ;
+ * un thread d'ecriture, endormi tant que la file est vide, les met en
+ * forme dans un tampon et l'ecrit par blocs de chunkSize octets. Tout ce
+ * qui a ete accepte par write est ecrit au plus tard par close() ou le
+ * destructeur ; seul close() signale un echec d'ecriture.
+ */
+class SolutionWriter {
+private :
+    std::string fileName;
+    std::ofstream file;
+    OutputFormat format;
+    Backpressure policy;
+    size_t chunkSize;
+    RingBuffer<PackedSolution> ring;
+    std::atomic<bool> closing;
+    std::atomic<size_t> nbDropped;
+    std::atomic<bool> sleeping;          // le thread d'ecriture attend sur wakeUp
+    std::mutex mutex;
+    std::condition_variable wakeUp;
+    std::thread writer;
+
+    void run();
+    void notifyWriter();
+    void formatSolution(const PackedSolution& solution, std::string& buffer) const;
+
+public :
+    /**
+     * @exception std::runtime_error si le fichier ne peut pas etre ouvert
+     */
+    explicit SolutionWriter(const std::string& fileName, OutputFormat format = OutputFormat::TEXT,
+                            Backpressure policy = Backpressure::WAIT,
+                            size_t ringCapacity = 1 << 14, size_t chunkSize = 1 << 20);
+
+    ~SolutionWriter();
+
+    SolutionWriter(const SolutionWriter&) = delete;
+    SolutionWriter& operator = (const SolutionWriter&) = delete;
+
+    /**
+     * @brief Transmet une solution au thread d'ecriture
+     *
+     * @return false si la solution a ete perdue (Backpressure::DROP et file pleine)
+     *
+     * @exception std::invalid_argument si la solution a plus de PackedSolution::MAX_PIECES pieces
+     */
+    bool write(const Puzzle& puzzle);
+
+    /**
+     * @brief Ecrit tout ce qui est en attente puis ferme le fichier
+     *
+     * @exception std::runtime_error si une ecriture ou la fermeture a echoue
+     */
+    void close();
+
+    size_t dropped() const;
+};
+
+#endif
@@ -0,0 +1,126 @@
+/*
+ -----------------------------------------------------------------------------------
+ Laboratoire : ASD1 Cube magique
+ Fichier     : solver_context.cpp
+ Auteur(s)   : Jorge-André Fulgencio Esteves <jorgeand.fulgencioesteves@heig-vd.ch>,
+               Florian Schaufelberger <florian.schaufelberger@heig-vd.ch>,
+               Jonathan Zaehringer <jonathan.zaehringer@heig-vd.ch>
+
+ Date        : 27.03.2018
+
+ Compilateur : Apple LLVM version 9.0.0 (clang-900.0.39.2)
+               gcc version 5.4.0 20160609 (Ubuntu 5.4.0-6ubuntu1~16.04.9)
+               gcc version 7.2.0 (Debian 7.2.0-19)
+ -----------------------------------------------------------------------------------
+*/
+#include <stdexcept>
+#include <algorithm>
+
+#include "solver_context.h"
+#include "fixed_solver.h"
+#include "result_cache.h"
+
+using namespace std;
+
+namespace {
+    template <typename Kind>
+    vector<uint_fast32_t> placementsOf() {
+        typedef Placements<Board<3, 3, 3>, Kind> P;
+        vector<uint_fast32_t> masks;
+        for(size_t i = 0; i < P::SIZE; i++) {
+            masks.push_back(uint_fast32_t(P::TABLE.masks[i]));
+        }
+        return masks;
+    }
+}
+
+vector<uint_fast32_t> SolverContext::placementsOf(char name) {
+    switch(name) {
+        case 'C':
+            return ::placementsOf<CBase>();
+        case 'T':
+            return ::placementsOf<TBase>();
+        case 'S':
+            return ::placementsOf<SBase>();
+        case 'L':
+            return ::placementsOf<LBase>();
+        default:
+            throw invalid_argument(string("SolverContext : piece inconnue ") + name);
+    }
+}
+
+SolverContext::SolverContext(const string& pieceNames, uint_fast32_t blocked)
+    : pieceNames(pieceNames), blocked(blocked) {
+    for(char name : pieceNames) {
+        vector<uint_fast32_t> masks = placementsOf(name);
+        masks.erase(remove_if(masks.begin(), masks.end(), [blocked](uint_fast32_t m) { return (m & blocked) != 0; }),
+                    masks.end());
+        placements.push_back(masks);
+    }
+}
+
+const string& SolverContext::getPieceNames() const {
+    return pieceNames;
+}
+
+uint_fast32_t SolverContext::getBlocked() const {
+    return blocked;
+}
+
+const vector<vector<uint_fast32_t>>& SolverContext::getPlacements() const {
+    return placements;
+}
+
+size_t SolverContext::count() const {
+    return count(blocked, placements.size());
+}
+
+void SolverContext::solve(Puzzles& solutions) const {
+    Puzzle puzzle;
+    solve(solutions, puzzle, blocked, placements.size());
+}
+
+size_t SolverContext::count(uint_fast32_t cube, size_t index) const {
+    if(index == 0) {
+        return 1;
+    }
+
+    size_t n = 0;
+    for(uint_fast32_t m : placements[index - 1]) {
+        if((cube & m) == 0) {
+            n += count(cube | m, index - 1);
+        }
+    }
+    return n;
+}
+
+void SolverContext::solve(Puzzles& solutions, Puzzle& puzzle, uint_fast32_t cube, size_t index) const {
+    if(index == 0) {
+        solutions.push_back(puzzle);
+        return;
+    }
+
+    for(uint_fast32_t m : placements[index - 1]) {
+        if((cube & m) == 0) {
+            puzzle.tryToInsert(Piece(toShape(m), m, unsigned(index - 1), pieceNames[index - 1]));
+            solve(solutions, puzzle, cube | m, index - 1);
+            puzzle.popLastPiece();
+        }
+    }
+}
+
+vector<InstanceResult> solveBatch(ThreadPool& pool, const vector<Instance>& instances, ResultCache* cache) {
+    vector<InstanceResult> results(instances.size(), InstanceResult{0, ""});
+
+    pool.parallelFor(instances.size(), [&](size_t i) {
+        try {
+            const Instance& instance = instances[i];
+            results[i].count = cache ? cache->count(instance.pieceNames, instance.blocked)
+                                     : SolverContext(instance.pieceNames, instance.blocked).count();
+        } catch(const exception& e) {
+            results[i].error = e.what();
+        }
+    });
+
+    return results;
+}
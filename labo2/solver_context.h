@@ -0,0 +1,99 @@
+/*
+ -----------------------------------------------------------------------------------
+ Laboratoire : ASD1 Cube magique
+ Fichier     : solver_context.h
+ Auteur(s)   : Jorge-André Fulgencio Esteves <jorgeand.fulgencioesteves@heig-vd.ch>,
+               Florian Schaufelberger <florian.schaufelberger@heig-vd.ch>,
+               Jonathan Zaehringer <jonathan.zaehringer@heig-vd.ch>
+
+ Date        : 27.03.2018
+
+ Compilateur : Apple LLVM version 9.0.0 (clang-900.0.39.2)
+               gcc version 5.4.0 20160609 (Ubuntu 5.4.0-6ubuntu1~16.04.9)
+               gcc version 7.2.0 (Debian 7.2.0-19)
+ -----------------------------------------------------------------------------------
+*/
+#ifndef SOLVER_CONTEXT_H
+#define SOLVER_CONTEXT_H
+
+#include <vector>
+#include <string>
+
+#include "puzzle.h"
+#include "thread_pool.h"
+
+/**
+ * Instance de puzzle independante : possede ses propres tables de
+ * placements, contrairement aux membres statiques C::positions, L::positions...
+ * Plusieurs contextes peuvent donc etre resolus en parallele.
+ *
+ * Les pieces sont posees de la derniere a la premiere, comme dans
+ * bruteForceMagicCube, et recoivent comme identifiant leur indice.
+ */
+class SolverContext {
+private :
+    std::string pieceNames;
+    uint_fast32_t blocked;
+    std::vector<std::vector<uint_fast32_t>> placements;
+
+    size_t count(uint_fast32_t cube, size_t index) const;
+    void solve(Puzzles& solutions, Puzzle& puzzle, uint_fast32_t cube, size_t index) const;
+
+public :
+    /**
+     * @param[in] pieceNames multiensemble des pieces, p.ex. "LLLLTSC"
+     * @param[in] blocked    cases deja occupees (bit x + 3 * y + 9 * z)
+     *
+     * @exception std::invalid_argument si une piece est inconnue
+     */
+    SolverContext(const std::string& pieceNames, uint_fast32_t blocked = 0);
+
+    const std::string& getPieceNames() const;
+    uint_fast32_t getBlocked() const;
+
+    /**
+     * @brief Placements libres de chaque piece, dans l'ordre de pieceNames
+     */
+    const std::vector<std::vector<uint_fast32_t>>& getPlacements() const;
+
+    /**
+     * @brief Nombre de solutions (permutations des pieces semblables comprises)
+     */
+    size_t count() const;
+
+    /**
+     * @brief Ajoute toutes les solutions a la liste
+     */
+    void solve(Puzzles& solutions) const;
+
+    /**
+     * @brief Placements sur le cube vide d'une piece, dans l'ordre de Piece::generateAllPositions
+     *
+     * @exception std::invalid_argument si la piece est inconnue
+     */
+    static std::vector<uint_fast32_t> placementsOf(char name);
+};
+
+struct Instance {
+    std::string pieceNames;
+    uint_fast32_t blocked;
+};
+
+struct InstanceResult {
+    size_t count;
+    std::string error;   // vide si l'instance a ete resolue
+};
+
+class ResultCache;
+
+/**
+ * @brief Resout un lot d'instances sur un pool de threads partage
+ *
+ * @param[in] cache si non nul, les instances deja resolues (ou symetriques) n'y sont pas recherchees
+ *
+ * @return le resultat de chaque instance, dans l'ordre du lot
+ */
+std::vector<InstanceResult> solveBatch(ThreadPool& pool, const std::vector<Instance>& instances,
+                                       ResultCache* cache = nullptr);
+
+#endif
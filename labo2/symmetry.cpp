@@ -0,0 +1,61 @@
+/*
+ -----------------------------------------------------------------------------------
+ Laboratoire : ASD1 Cube magique
+ Fichier     : symmetry.cpp
+ Auteur(s)   : Jorge-André Fulgencio Esteves <jorgeand.fulgencioesteves@heig-vd.ch>,
+               Florian Schaufelberger <florian.schaufelberger@heig-vd.ch>,
+               Jonathan Zaehringer <jonathan.zaehringer@heig-vd.ch>
+
+ Date        : 27.03.2018
+
+ Compilateur : Apple LLVM version 9.0.0 (clang-900.0.39.2)
+               gcc version 5.4.0 20160609 (Ubuntu 5.4.0-6ubuntu1~16.04.9)
+               gcc version 7.2.0 (Debian 7.2.0-19)
+ -----------------------------------------------------------------------------------
+*/
+#include <array>
+#include <algorithm>
+
+#include "symmetry.h"
+
+using namespace std;
+
+namespace {
+    typedef array<array<uint8_t, 27>, NB_SYMMETRIES> Symmetries;
+
+    // Image de chaque case par les 48 symetries du cube
+    Symmetries buildSymmetries() {
+        Symmetries symmetries;
+        array<int, 3> axes = {{0, 1, 2}};
+        size_t g = 0;
+
+        do {
+            for(int flips = 0; flips < 8; flips++, g++) {
+                for(int cell = 0; cell < 27; cell++) {
+                    const int p[3] = {cell % 3, (cell / 3) % 3, cell / 9};
+                    int q[3];
+                    for(int i = 0; i < 3; i++) {
+                        q[i] = (flips >> i) & 1 ? 2 - p[axes[size_t(i)]] : p[axes[size_t(i)]];
+                    }
+                    symmetries[g][size_t(cell)] = uint8_t(q[0] + 3 * q[1] + 9 * q[2]);
+                }
+            }
+        } while(next_permutation(axes.begin(), axes.end()));
+
+        return symmetries;
+    }
+
+    const Symmetries& symmetries() {
+        static const Symmetries table = buildSymmetries();
+        return table;
+    }
+}
+
+uint_fast32_t transform(uint_fast32_t mask, size_t g) {
+    const Symmetries& table = symmetries();
+    uint_fast32_t image = 0;
+    for(uint32_t m = uint32_t(mask); m != 0; m &= m - 1) {
+        image |= uint_fast32_t(1) << table[g][size_t(__builtin_ctz(m))];
+    }
+    return image;
+}
@@ -0,0 +1,30 @@
+/*
+ -----------------------------------------------------------------------------------
+ Laboratoire : ASD1 Cube magique
+ Fichier     : symmetry.h
+ Auteur(s)   : Jorge-André Fulgencio Esteves <jorgeand.fulgencioesteves@heig-vd.ch>,
+               Florian Schaufelberger <florian.schaufelberger@heig-vd.ch>,
+               Jonathan Zaehringer <jonathan.zaehringer@heig-vd.ch>
+
+ Date        : 27.03.2018
+
+ Compilateur : Apple LLVM version 9.0.0 (clang-900.0.39.2)
+               gcc version 5.4.0 20160609 (Ubuntu 5.4.0-6ubuntu1~16.04.9)
+               gcc version 7.2.0 (Debian 7.2.0-19)
+ -----------------------------------------------------------------------------------
+*/
+#ifndef SYMMETRY_H
+#define SYMMETRY_H
+
+#include <cstddef>
+#include <cstdint>
+
+// Symetries du cube 3x3x3 : 6 permutations des axes x 8 reflexions (l'identite est la premiere)
+const size_t NB_SYMMETRIES = 48;
+
+/**
+ * @brief Image d'un ensemble de cases (bit x + 3 * y + 9 * z) par la symetrie g
+ */
+uint_fast32_t transform(uint_fast32_t mask, size_t g);
+
+#endif
@@ -16,28 +16,11 @@
 #include <vector>
 
 #include "t.h"
+#include "base_shapes.h"
 
 using namespace std;
 
-Shapes T::POSITION_BASE = {
-    Shape{Point{0,0,0}, Point{1,0,0}, Point{2,0,0}, Point{1,1,0}},
-    Shape{Point{0,1,0}, Point{1,1,0}, Point{2,1,0}, Point{1,0,0}},
-
-    Shape{Point{0,0,0}, Point{0,1,0}, Point{0,2,0}, Point{1,1,0}},
-    Shape{Point{1,0,0}, Point{1,1,0}, Point{1,2,0}, Point{0,1,0}},
-
-    Shape{Point{0,0,0}, Point{1,0,0}, Point{2,0,0}, Point{1,0,1}},
-    Shape{Point{0,0,1}, Point{1,0,1}, Point{2,0,1}, Point{1,0,0}},
-
-    Shape{Point{0,0,0}, Point{0,0,1}, Point{0,0,2}, Point{1,0,1}},
-    Shape{Point{0,0,0}, Point{0,0,1}, Point{0,0,2}, Point{0,1,1}},
-
-    Shape{Point{1,0,0}, Point{1,0,1}, Point{1,0,2}, Point{0,0,1}},
-    Shape{Point{0,1,0}, Point{0,1,1}, Point{0,1,2}, Point{0,0,1}},
-    
-    Shape{Point{0,0,1}, Point{0,1,1}, Point{0,2,1}, Point{0,1,0}},
-    Shape{Point{0,0,0}, Point{0,1,0}, Point{0,2,0}, Point{0,1,1}},
-};
+Shapes T::POSITION_BASE = toShapes(TBase::SHAPES);
 
 Shapes T::positions;
 vector<uint_fast32_t> T::fast_positions;
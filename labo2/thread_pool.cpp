@@ -0,0 +1,99 @@
+/*
+ -----------------------------------------------------------------------------------
+ Laboratoire : ASD1 Cube magique
+ Fichier     : thread_pool.cpp
+ Auteur(s)   : Jorge-André Fulgencio Esteves <jorgeand.fulgencioesteves@heig-vd.ch>,
+               Florian Schaufelberger <florian.schaufelberger@heig-vd.ch>,
+               Jonathan Zaehringer <jonathan.zaehringer@heig-vd.ch>
+
+ Date        : 27.03.2018
+
+ Compilateur : Apple LLVM version 9.0.0 (clang-900.0.39.2)
+               gcc version 5.4.0 20160609 (Ubuntu 5.4.0-6ubuntu1~16.04.9)
+               gcc version 7.2.0 (Debian 7.2.0-19)
+ -----------------------------------------------------------------------------------
+*/
+#include <exception>
+
+#include "thread_pool.h"
+
+ThreadPool::ThreadPool(unsigned nbThreads) : stopping(false) {
+    if(nbThreads == 0) {
+        nbThreads = 1;
+    }
+    for(unsigned i = 0; i < nbThreads; i++) {
+        workers.emplace_back(&ThreadPool::work, this);
+    }
+}
+
+ThreadPool::~ThreadPool() {
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        stopping = true;
+    }
+    available.notify_all();
+
+    for(std::thread& t : workers) {
+        t.join();
+    }
+}
+
+void ThreadPool::submit(std::function<void()> task) {
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        tasks.push(std::move(task));
+    }
+    available.notify_one();
+}
+
+void ThreadPool::parallelFor(size_t n, const std::function<void(size_t)>& task) {
+    std::mutex m;
+    std::condition_variable finished;
+    size_t remaining = n;
+    std::exception_ptr error;
+
+    for(size_t i = 0; i < n; i++) {
+        submit([&, i] {
+            std::exception_ptr e;
+            try {
+                task(i);
+            } catch(...) {
+                e = std::current_exception();
+            }
+
+            std::lock_guard<std::mutex> lock(m);
+            if(e && !error) {
+                error = e;
+            }
+            if(--remaining == 0) {
+                finished.notify_one();
+            }
+        });
+    }
+
+    std::unique_lock<std::mutex> lock(m);
+    finished.wait(lock, [&remaining] { return remaining == 0; });
+    if(error) {
+        std::rethrow_exception(error);
+    }
+}
+
+size_t ThreadPool::size() const {
+    return workers.size();
+}
+
+void ThreadPool::work() {
+    for(;;) {
+        std::function<void()> task;
+        {
+            std::unique_lock<std::mutex> lock(mutex);
+            available.wait(lock, [this] { return stopping || !tasks.empty(); });
+            if(tasks.empty()) {
+                return;
+            }
+            task = std::move(tasks.front());
+            tasks.pop();
+        }
+        task();
+    }
+}
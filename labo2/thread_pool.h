@@ -0,0 +1,68 @@
+/*
+ -----------------------------------------------------------------------------------
+ Laboratoire : ASD1 Cube magique
+ Fichier     : thread_pool.h
+ Auteur(s)   : Jorge-André Fulgencio Esteves <jorgeand.fulgencioesteves@heig-vd.ch>,
+               Florian Schaufelberger <florian.schaufelberger@heig-vd.ch>,
+               Jonathan Zaehringer <jonathan.zaehringer@heig-vd.ch>
+
+ Date        : 27.03.2018
+
+ Compilateur : Apple LLVM version 9.0.0 (clang-900.0.39.2)
+               gcc version 5.4.0 20160609 (Ubuntu 5.4.0-6ubuntu1~16.04.9)
+               gcc version 7.2.0 (Debian 7.2.0-19)
+ -----------------------------------------------------------------------------------
+*/
+#ifndef THREAD_POOL_H
+#define THREAD_POOL_H
+
+#include <vector>
+#include <queue>
+#include <functional>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+
+/**
+ * Ensemble fixe de threads executant les taches soumises dans l'ordre
+ * d'arrivee. Le pool peut etre partage entre plusieurs appelants.
+ */
+class ThreadPool {
+private :
+    std::vector<std::thread> workers;
+    std::queue<std::function<void()>> tasks;
+    std::mutex mutex;
+    std::condition_variable available;
+    bool stopping;
+
+    void work();
+
+public :
+    /**
+     * @param[in] nbThreads nombre de threads, au moins un
+     */
+    explicit ThreadPool(unsigned nbThreads = std::thread::hardware_concurrency());
+
+    /**
+     * @brief Termine les taches deja soumises puis arrete les threads
+     */
+    ~ThreadPool();
+
+    ThreadPool(const ThreadPool&) = delete;
+    ThreadPool& operator = (const ThreadPool&) = delete;
+
+    void submit(std::function<void()> task);
+
+    /**
+     * @brief Execute task(0) ... task(n - 1) sur le pool et attend qu'elles soient toutes terminees
+     *
+     * A ne pas appeler depuis une tache du pool, qui attendrait alors sa propre file.
+     *
+     * @exception la premiere exception levee par une tache, relancee une fois toutes les taches terminees
+     */
+    void parallelFor(size_t n, const std::function<void(size_t)>& task);
+
+    size_t size() const;
+};
+
+#endif
@@ -0,0 +1,226 @@
+//
+//  Benchmark.cpp
+//
+//  Jonathan Zaehringer
+//  Jorge-Andre Fulgencio Esteves
+//  Florian Schaufelberger
+//
+//  Compilation : g++ -std=c++11 -O2 -pthread benchmark.cpp -o benchmark
+//
+
+#include <chrono>
+#include <random>
+#include <vector>
+#include <iomanip>
+
+#include "linked_list.cpp"
+#include "skip_list.cpp"
+#include "unrolled_list.cpp"
+#include "concurrent_stack.cpp"
+
+/**
+ * @brief Duree d'execution d'une fonction, en millisecondes
+ */
+template <typename F>
+double milliseconds(F f) {
+    auto start = chrono::steady_clock::now();
+    f();
+    return chrono::duration<double, milli>(chrono::steady_clock::now() - start).count();
+}
+
+/**
+ * @brief Operations par position aleatoire (at, insert, erase) sur une liste de n elements
+ *
+ * @return duree totale des operations, en millisecondes
+ */
+template <typename List>
+double randomPositions(size_t n, size_t nbOperations, long& checksum) {
+    List liste;
+    for(size_t i = 0; i < n; ++i) {
+        liste.push_back(int(i));
+    }
+
+    mt19937 random(42);
+    return milliseconds([&] {
+        for(size_t i = 0; i < nbOperations; ++i) {
+            size_t pos = random() % liste.size();
+            switch(i % 3) {
+                case 0: checksum += liste.at(pos); break;
+                case 1: liste.insert(int(i), pos); break;
+                case 2: liste.erase(pos); break;
+            }
+        }
+    });
+}
+
+void benchmarkPositions() {
+    const size_t NB_OPERATIONS = 30000;
+
+    cout << "Operations par position aleatoire (" << NB_OPERATIONS << " at/insert/erase)\n";
+    cout << setw(10) << "n" << setw(16) << "LinkedList [ms]" << setw(16) << "SkipList [ms]" << "\n";
+
+    for(size_t n = 1000; n <= 100000; n *= 10) {
+        long linked = 0, skip = 0;
+        double linkedTime = randomPositions<LinkedList<int>>(n, NB_OPERATIONS, linked);
+        double skipTime = randomPositions<SkipList<int>>(n, NB_OPERATIONS, skip);
+
+        cout << setw(10) << n << fixed << setprecision(2)
+             << setw(16) << linkedTime << setw(16) << skipTime
+             << (linked == skip ? "" : "  resultats differents !") << "\n";
+    }
+}
+
+/**
+ * @brief Parcours complets (find d'une valeur absente, puis tri) d'une liste de n entiers aleatoires
+ *
+ * @return durees du find et du tri, en millisecondes
+ */
+template <typename List>
+pair<double, double> traversals(size_t n, size_t nbFinds, size_t& checksum) {
+    List liste;
+    mt19937 random(42);
+    for(size_t i = 0; i < n; ++i) {
+        liste.push_back(int(random() % n));
+    }
+
+    double findTime = milliseconds([&] {
+        for(size_t i = 0; i < nbFinds; ++i) {
+            checksum += liste.find(-1);
+        }
+    });
+    double sortTime = milliseconds([&] { liste.sort(); });
+    checksum += size_t(liste.at(n / 2));
+
+    return make_pair(findTime, sortTime);
+}
+
+void benchmarkTraversals() {
+    const size_t N = 1000000, NB_FINDS = 20;
+
+    cout << "\nParcours d'une liste de " << N << " entiers (" << NB_FINDS << " find, puis sort)\n";
+    cout << setw(16) << "" << setw(12) << "find [ms]" << setw(12) << "sort [ms]" << "\n";
+
+    size_t linked = 0, unrolled = 0;
+    pair<double, double> linkedTimes = traversals<LinkedList<int>>(N, NB_FINDS, linked);
+    pair<double, double> unrolledTimes = traversals<UnrolledList<int>>(N, NB_FINDS, unrolled);
+
+    cout << fixed << setprecision(2)
+         << setw(16) << "LinkedList" << setw(12) << linkedTimes.first << setw(12) << linkedTimes.second << "\n"
+         << setw(16) << "UnrolledList" << setw(12) << unrolledTimes.first << setw(12) << unrolledTimes.second
+         << (linked == unrolled ? "" : "  resultats differents !") << "\n";
+}
+
+void benchmarkParallelSort() {
+    const size_t N = 10000000;
+
+    cout << "\nTri de " << N << " entiers aleatoires (" << thread::hardware_concurrency() << " coeurs)\n";
+    cout << setw(10) << "threads" << setw(12) << "[ms]" << setw(12) << "speedup" << "\n";
+
+    // Maillons par blocs : chaque liste est contigue en memoire, quel que soit
+    // l'etat du tas laisse par la precedente
+    double reference = 0;
+    for(size_t nbThreads = 1; nbThreads <= 8; nbThreads *= 2) {
+        LinkedList<int, NoTrace, NodePool<int>> liste;
+        mt19937 random(42);
+        for(size_t i = 0; i < N; ++i) {
+            liste.push_back(int(random() % N));
+        }
+
+        double time = milliseconds([&] { liste.parallel_sort(nbThreads); });
+        if(nbThreads == 1) {
+            reference = time;
+        }
+
+        cout << setw(10) << nbThreads << fixed << setprecision(2)
+             << setw(12) << time << setw(12) << reference / time << "\n";
+    }
+}
+
+/**
+ * @brief LinkedList protegee par un mutex, reference pour ConcurrentStack
+ */
+class MutexStack {
+    LinkedList<int> liste;
+    std::mutex access;
+
+public:
+    void push_front(int value) {
+        lock_guard<std::mutex> lock(access);
+        liste.push_front(value);
+    }
+
+    Optional<int> try_pop() {
+        lock_guard<std::mutex> lock(access);
+        if(liste.size() == 0) {
+            return Optional<int>();
+        }
+        Optional<int> value(liste.front());
+        liste.pop_front();
+        return value;
+    }
+};
+
+/**
+ * @brief nbPairs producteurs et nbPairs consommateurs se partagent une pile
+ *
+ * @return debit en millions d'operations (push ou pop) par seconde
+ */
+template <typename Stack>
+double stackThroughput(size_t nbPairs, size_t nbPerProducer, long& checksum) {
+    Stack stack;
+    atomic<long> sum(0);
+    atomic<size_t> popped(0);
+    const size_t total = nbPairs * nbPerProducer;
+
+    double time = milliseconds([&] {
+        vector<thread> threads;
+        for(size_t p = 0; p < nbPairs; ++p) {
+            threads.emplace_back([&stack, nbPerProducer] {
+                for(size_t i = 0; i < nbPerProducer; ++i) {
+                    stack.push_front(int(i));
+                }
+            });
+            threads.emplace_back([&stack, &sum, &popped, total] {
+                long local = 0;
+                while(popped.load(memory_order_relaxed) < total) {
+                    Optional<int> value = stack.try_pop();
+                    if(value) {
+                        local += *value;
+                        popped.fetch_add(1, memory_order_relaxed);
+                    }
+                }
+                sum += local;
+            });
+        }
+        for(thread& t : threads) {
+            t.join();
+        }
+    });
+
+    checksum += sum;
+    return 2.0 * double(total) / time / 1000.0;
+}
+
+void benchmarkConcurrentStack() {
+    const size_t NB_PER_PRODUCER = 500000;
+
+    cout << "\nPile partagee, " << NB_PER_PRODUCER << " push par producteur (" << thread::hardware_concurrency() << " coeurs)\n";
+    cout << setw(22) << "producteurs/conso." << setw(16) << "mutex [Mop/s]" << setw(16) << "Treiber [Mop/s]" << "\n";
+
+    for(size_t nbPairs = 1; nbPairs <= 4; nbPairs *= 2) {
+        long locked = 0, lockFree = 0;
+        double lockedRate = stackThroughput<MutexStack>(nbPairs, NB_PER_PRODUCER, locked);
+        double lockFreeRate = stackThroughput<ConcurrentStack<int>>(nbPairs, NB_PER_PRODUCER, lockFree);
+
+        cout << setw(22) << nbPairs << fixed << setprecision(2)
+             << setw(16) << lockedRate << setw(16) << lockFreeRate
+             << (locked == lockFree ? "" : "  resultats differents !") << "\n";
+    }
+}
+
+int main() {
+    benchmarkPositions();
+    benchmarkTraversals();
+    benchmarkParallelSort();
+    benchmarkConcurrentStack();
+}
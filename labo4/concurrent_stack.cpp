@@ -0,0 +1,442 @@
+//
+//  ConcurrentStack.cpp
+//
+//  Jonathan Zaehringer
+//  Jorge-Andre Fulgencio Esteves
+//  Florian Schaufelberger
+//
+
+#ifndef _CONCURRENT_STACK_CPP_
+#define _CONCURRENT_STACK_CPP_
+
+#include <atomic>
+#include <algorithm>
+#include <cassert>
+#include <mutex>
+#include <new>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+#include <utility>
+#include <vector>
+using namespace std;
+
+/**
+ * Valeur eventuelle, a la maniere de std::optional (C++17)
+ */
+template <typename T>
+class Optional {
+    bool engaged;
+    typename aligned_storage<sizeof(T), alignof(T)>::type storage;
+
+public:
+    /// Sans valeur
+    Optional() noexcept : engaged(false) {
+    }
+
+    Optional( T&& value ) : engaged(true) {
+        ::new(static_cast<void*>(&storage)) T(std::move(value));
+    }
+
+    Optional( const T& value ) : engaged(true) {
+        ::new(static_cast<void*>(&storage)) T(value);
+    }
+
+    Optional( const Optional& other ) : engaged(false) {
+        if(other.engaged) {
+            ::new(static_cast<void*>(&storage)) T(*other);
+            engaged = true;
+        }
+    }
+
+    Optional( Optional&& other ) : engaged(false) {
+        if(other.engaged) {
+            ::new(static_cast<void*>(&storage)) T(std::move(*other));
+            engaged = true;
+        }
+    }
+
+    Optional& operator= ( Optional other ) {
+        reset();
+        if(other.engaged) {
+            ::new(static_cast<void*>(&storage)) T(std::move(*other));
+            engaged = true;
+        }
+        return *this;
+    }
+
+    ~Optional() {
+        reset();
+    }
+
+    /// Detruit la valeur eventuelle
+    void reset() noexcept {
+        if(engaged) {
+            (**this).~T();
+            engaged = false;
+        }
+    }
+
+    bool has_value() const noexcept { return engaged; }
+    explicit operator bool() const noexcept { return engaged; }
+
+    T& operator* () noexcept { return *reinterpret_cast<T*>(&storage); }
+    const T& operator* () const noexcept { return *reinterpret_cast<const T*>(&storage); }
+    T* operator-> () noexcept { return &**this; }
+    const T* operator-> () const noexcept { return &**this; }
+
+    /**
+     *  @brief Acces a la valeur
+     *
+     *  @exception std::logic_error("Optional::value") si pas de valeur
+     */
+    T& value() {
+        if(!engaged) {
+            throw std::logic_error("Optional::value");
+        }
+        return **this;
+    }
+};
+
+/**
+ * Pointeurs de danger (hazard pointers), partages par toutes les piles
+ *
+ * Chaque thread dispose d'un pointeur de danger, pris a sa premiere
+ * utilisation dans une table de MAX_THREADS emplacements et rendu a sa fin.
+ * Un thread y publie le maillon qu'il s'apprete a lire ; un maillon retire
+ * d'une pile n'est libere qu'une fois qu'aucun pointeur de danger ne le
+ * designe. Les maillons retires sont examines par lots de 2 * MAX_THREADS,
+ * soit un cout amorti de O(1) par maillon.
+ *
+ * La liste des objets retires d'un thread est reservee a sa premiere
+ * utilisation : retire, l'examen d'un lot et la fin d'un thread n'allouent
+ * plus rien et ne levent aucune exception.
+ */
+class HazardPointers {
+public:
+    static const size_t MAX_THREADS = 128;
+
+    /// Liberation d'un objet retire, selon son type
+    typedef void (*Deleter)(void*);
+
+private:
+    struct Slot {
+        atomic<bool> used;
+        atomic<void*> pointer;
+    };
+
+    struct Retired {
+        void* pointer;
+        Deleter deleter;
+    };
+
+    /// Objets retires par des threads termines avant de pouvoir les liberer,
+    /// repris par le prochain thread qui obtient le meme emplacement
+    struct Orphans {
+        std::mutex access;
+        vector<Retired> retired[MAX_THREADS];
+
+        ~Orphans() {
+            for(const vector<Retired>& parked : retired) {
+                for(const Retired& r : parked) {
+                    r.deleter(r.pointer);
+                }
+            }
+        }
+    };
+
+    /// Emplacement et objets retires du thread courant
+    struct Owner {
+        Slot* slot;
+        vector<Retired> retired;
+
+        Owner() : slot(nullptr) {
+            for(size_t i = 0; i < MAX_THREADS && !slot; i++) {
+                bool expected = false;
+                if(slots()[i].used.compare_exchange_strong(expected, true)) {
+                    slot = &slots()[i];
+                }
+            }
+            if(!slot) {
+                throw std::runtime_error("HazardPointers : plus de " + to_string(MAX_THREADS) + " threads");
+            }
+
+            // Au plus MAX_THREADS objets laisses par le thread precedent (proteges a sa fin)
+            try {
+                {
+                    lock_guard<std::mutex> lock(orphans().access);
+                    retired.swap(orphans().retired[slot - slots()]);
+                }
+                retired.reserve(2 * MAX_THREADS);
+            } catch(...) {
+                slot->used.store(false);
+                throw;
+            }
+        }
+
+        ~Owner() {
+            slot->pointer.store(nullptr);
+            reclaim(retired);
+            {
+                // L'emplacement a ete vide par le constructeur : simple echange, sans allocation
+                lock_guard<std::mutex> lock(orphans().access);
+                retired.swap(orphans().retired[slot - slots()]);
+            }
+            slot->used.store(false);
+        }
+    };
+
+    static Slot* slots() noexcept {
+        static Slot table[MAX_THREADS];
+        return table;
+    }
+
+    static Orphans& orphans() {
+        static Orphans instance;
+        return instance;
+    }
+
+    static Owner& owner() {
+        thread_local Owner instance;
+        return instance;
+    }
+
+    /**
+     * @brief Libere les objets retires qu'aucun pointeur de danger ne designe
+     *
+     * @remark Complexite de O((r + t) log t), r objets retires et t emplacements
+     */
+    static void reclaim( vector<Retired>& retired ) noexcept {
+        void* hazards[MAX_THREADS];
+        size_t nbHazards = 0;
+        for(size_t i = 0; i < MAX_THREADS; i++) {
+            if(void* p = slots()[i].pointer.load()) {
+                hazards[nbHazards++] = p;
+            }
+        }
+        void** end = hazards + nbHazards;
+        sort(hazards, end);
+
+        auto kept = remove_if(retired.begin(), retired.end(), [&hazards, end](const Retired& r) {
+            if(binary_search(hazards, end, r.pointer)) {
+                return false;
+            }
+            r.deleter(r.pointer);
+            return true;
+        });
+        retired.erase(kept, retired.end());
+    }
+
+public:
+    /**
+     *  @brief Pointeur de danger du thread courant
+     *
+     *  @exception std::runtime_error si plus de MAX_THREADS threads en ont un
+     */
+    static atomic<void*>& local() {
+        return owner().slot->pointer;
+    }
+
+    /**
+     *  @brief Confie un objet retire de toute structure partagee, libere par
+     *         deleter des qu'aucun thread ne le protege plus
+     *
+     *  Le thread doit deja avoir obtenu son pointeur de danger par local().
+     *  Apres chaque lot il reste au plus MAX_THREADS objets proteges : la
+     *  reserve de 2 * MAX_THREADS n'est jamais depassee.
+     *
+     *  @remark Complexite de O(1) amorti
+     */
+    static void retire( void* pointer, Deleter deleter ) noexcept {
+        vector<Retired>& retired = owner().retired;
+        assert(retired.size() < retired.capacity());
+        retired.push_back(Retired{pointer, deleter});
+
+        if(retired.size() >= 2 * MAX_THREADS) {
+            reclaim(retired);
+        }
+    }
+};
+
+/**
+ * Pile partagee sans verrou (pile de Treiber) : memes operations de tete que
+ * LinkedList, utilisables par plusieurs threads a la fois sans mutex.
+ *
+ * push_front et try_pop modifient la tete par compare-and-swap ; un maillon
+ * depile n'est libere qu'une fois qu'aucun thread n'est en train de le lire
+ * (HazardPointers), ce qui ecarte aussi le probleme ABA.
+ */
+template < typename T > class ConcurrentStack {
+public:
+    using value_type = T;
+    using reference = T&;
+    using const_reference = const T&;
+
+private:
+    /**
+     *  @brief Maillon de la chaine.
+     *
+     * contient une valeur et le lien vers le maillon suivant.
+     */
+    struct Node {
+        value_type data;
+        Node* next;
+
+        template <typename... Args>
+        Node(Args&&... args) : data(std::forward<Args>(args)...), next(nullptr) {
+        }
+
+        static void destroy( void* node ) {
+            delete static_cast<Node*>(node);
+        }
+    };
+
+private:
+    /**
+     *  @brief  Tete de la pile
+     */
+    atomic<Node*> head;
+
+private:
+    /**
+     *  @brief Nombre d'elements, approximatif pendant les modifications concurrentes
+     */
+    atomic<size_t> nbElements;
+
+public:
+    /**
+     *  @brief Constructeur par defaut. Construit une pile vide
+     *
+     *  @remark Complexite de O(1)
+     */
+    ConcurrentStack() : head(nullptr), nbElements(0) {
+    }
+
+    ConcurrentStack( const ConcurrentStack& ) = delete;
+    ConcurrentStack& operator= ( const ConcurrentStack& ) = delete;
+
+public:
+    /**
+     *  @brief destructeur, a n'appeler qu'une fois tous les threads arretes
+     *
+     *  @remark Complexite de O(n), n etant la taille de la pile
+     */
+    ~ConcurrentStack() {
+        Node* node = head.load();
+        while(node) {
+            Node* next = node->next;
+            delete node;
+            node = next;
+        }
+    }
+
+public:
+    /**
+     *  @brief nombre d'elements stockes dans la pile
+     *
+     *  @return nombre d'elements, exact seulement sans modification concurrente
+     *
+     *  @remark Complexite de O(1)
+     */
+    size_t size() const noexcept {
+        return nbElements.load(memory_order_relaxed);
+    }
+
+    /**
+     *  @brief pile vide ?
+     *
+     *  @remark le resultat peut etre perime des son retour
+     *
+     *  @remark Complexite de O(1)
+     */
+    bool empty() const noexcept {
+        return head.load(memory_order_acquire) == nullptr;
+    }
+
+public:
+    /**
+     *  @brief insertion d'une valeur en tête de pile
+     *
+     *  @param[in] value la valeur a inserer
+     *
+     *  @exception std::bad_alloc si pas assez de memoire, où toute autre exception lancee par la constructeur de copie de value_type
+     *
+     *  @remark Complexite de O(1), plus les essais repetes en cas de concurrence
+     */
+    void push_front( const_reference value ) {
+        emplace_front(value);
+    }
+
+    void push_front( value_type&& value ) {
+        emplace_front(std::move(value));
+    }
+
+    /**
+     *  @brief construction d'une valeur directement en tête de pile
+     *
+     *  @param[in] args arguments transmis au constructeur de value_type
+     *
+     *  @exception std::bad_alloc si pas assez de memoire, où toute autre exception lancee par la constructeur de value_type
+     *
+     *  @remark Complexite de O(1), plus les essais repetes en cas de concurrence
+     */
+    template <typename... Args>
+    void emplace_front( Args&&... args ) {
+        Node* node = new Node(std::forward<Args>(args)...);
+
+        // Compte avant publication : un try_pop ne peut pas le faire passer sous zero
+        nbElements.fetch_add(1, memory_order_relaxed);
+
+        node->next = head.load(memory_order_relaxed);
+        while(!head.compare_exchange_weak(node->next, node, memory_order_release, memory_order_relaxed)) {
+        }
+    }
+
+public:
+    /**
+     *  @brief Retrait de l'element en tête de pile, s'il y en a un
+     *
+     *  Remplace front() suivi de pop_front(), qui ne peuvent etre atomiques ensemble.
+     *
+     *  @return la valeur retiree, ou rien si la pile est vide
+     *
+     *  @exception std::runtime_error si plus de HazardPointers::MAX_THREADS threads
+     *              utilisent des piles, std::bad_alloc, où toute autre exception lancee
+     *              par la constructeur de deplacement de value_type
+     *
+     *  @remark Complexite de O(1) amorti, plus les essais repetes en cas de concurrence
+     */
+    Optional<value_type> try_pop() {
+        atomic<void*>& hazard = HazardPointers::local();
+        Node* old = head.load();
+
+        do {
+            // Publie old, puis verifie qu'il est toujours en tete : il ne peut plus etre libere
+            Node* seen;
+            do {
+                seen = old;
+                hazard.store(seen);
+                old = head.load();
+            } while(old != seen);
+        } while(old && !head.compare_exchange_strong(old, old->next));
+
+        hazard.store(nullptr);
+
+        if(!old) {
+            return Optional<value_type>();
+        }
+
+        nbElements.fetch_sub(1, memory_order_relaxed);
+
+        // Seul ce thread a retire old : sa valeur lui appartient. Le maillon est
+        // confie a HazardPointers apres le deplacement, meme si celui-ci echoue
+        struct Retirement {
+            Node* node;
+            ~Retirement() { HazardPointers::retire(node, &Node::destroy); }
+        } retirement = { old };
+
+        return Optional<value_type>(std::move(old->data));
+    }
+};
+
+#endif
@@ -8,20 +8,305 @@
 //  Florian Schaufelberger
 //
 
+#ifndef _LINKED_LIST_CPP_
+#define _LINKED_LIST_CPP_
+
 #include <iostream>
 #include <stdexcept>
 #include <cassert>
+#include <cstddef>
+#include <functional>
+#include <memory>
+#include <new>
+#include <thread>
+#include <type_traits>
+#include <utility>
 using namespace std;
 
-/// Forward declaration classe
-template < typename T > class LinkedList;
+/**
+ * Politiques de trace des maillons : chacune recoit la valeur d'un maillon
+ * juste apres sa construction (constructed) et juste avant sa destruction
+ * (destroyed). Les fonctions sont statiques, la politique par defaut NoTrace
+ * disparait donc entierement a la compilation.
+ */
+
+/// Aucune trace (par defaut)
+struct NoTrace {
+    template <typename T> static void constructed(const T&) noexcept {}
+    template <typename T> static void destroyed(const T&) noexcept {}
+};
 
-/// Forward declaration fonction d'affichage
+/// Trace sur cout : (C<valeur>) a la construction, (D<valeur>) a la destruction
+struct StreamTrace {
+    template <typename T> static void constructed(const T& data) { cout << "(C" << data << ") "; }
+    template <typename T> static void destroyed(const T& data) { cout << "(D" << data << ") "; }
+};
+
+/// Compte les maillons construits et detruits, tous types de valeurs confondus
+struct CountTrace {
+    static size_t& constructions() noexcept { static size_t n = 0; return n; }
+    static size_t& destructions() noexcept { static size_t n = 0; return n; }
+
+    /// Maillons actuellement vivants
+    static size_t alive() noexcept { return constructions() - destructions(); }
+
+    template <typename T> static void constructed(const T&) noexcept { ++constructions(); }
+    template <typename T> static void destroyed(const T&) noexcept { ++destructions(); }
+};
+
+/// Transmet chaque evenement a une fonction choisie par l'utilisateur
 template <typename T>
-ostream& operator << (ostream& os, const LinkedList<T>& liste);
+struct CallbackTrace {
+    enum Event { CONSTRUCTED, DESTROYED };
+
+    /// Fonction appelee pour chaque evenement, aucune si vide
+    static function<void(Event, const T&)>& callback() { static function<void(Event, const T&)> f; return f; }
+
+    static void constructed(const T& data) { if(callback()) callback()(CONSTRUCTED, data); }
+    static void destroyed(const T& data) { if(callback()) callback()(DESTROYED, data); }
+};
+
+/**
+ * Blocs d'un NodePool, partages par toutes ses copies, y compris celles
+ * reassociees (rebind) a un autre type : un seau par taille d'emplacement,
+ * chacun avec ses blocs de ChunkSize emplacements et sa liste libre.
+ */
+template <size_t ChunkSize>
+class NodePoolBlocks {
+public:
+    struct Bucket {
+        Bucket* next;
+        size_t slotSize;
+        void* chunks;       // bloc le plus recent en tete, son premier mot chaine le suivant
+        size_t used;        // emplacements deja distribues dans le bloc de tete
+        void* freeList;     // le premier mot d'un emplacement libre chaine le suivant
+    };
+
+private:
+    /// Les emplacements commencent apres le chainage, alignes pour tout type
+    static const size_t HEADER = (sizeof(void*) + alignof(max_align_t) - 1) / alignof(max_align_t) * alignof(max_align_t);
+
+    Bucket* buckets;
+
+public:
+    NodePoolBlocks() noexcept : buckets(nullptr) {
+    }
+
+    NodePoolBlocks(const NodePoolBlocks&) = delete;
+    NodePoolBlocks& operator = (const NodePoolBlocks&) = delete;
+
+    ~NodePoolBlocks() {
+        release();
+        while(buckets) {
+            Bucket* next = buckets->next;
+            delete buckets;
+            buckets = next;
+        }
+    }
+
+    /**
+     *  @brief Seau des emplacements de slotSize octets, cree au premier appel
+     *
+     *  @exception std::bad_alloc si pas assez de memoire
+     */
+    Bucket* bucket(size_t slotSize) {
+        for(Bucket* b = buckets; b; b = b->next) {
+            if(b->slotSize == slotSize) {
+                return b;
+            }
+        }
+        buckets = new Bucket{buckets, slotSize, nullptr, ChunkSize, nullptr};
+        return buckets;
+    }
+
+    /**
+     *  @exception std::bad_alloc si pas assez de memoire
+     *
+     *  @remark Complexite de O(1)
+     */
+    static void* allocate(Bucket* b) {
+        if(b->freeList) {
+            void* slot = b->freeList;
+            b->freeList = *static_cast<void**>(slot);
+            return slot;
+        }
+
+        if(b->used == ChunkSize) {
+            void* chunk = ::operator new(HEADER + ChunkSize * b->slotSize);
+            *static_cast<void**>(chunk) = b->chunks;
+            b->chunks = chunk;
+            b->used = 0;
+        }
+        return static_cast<char*>(b->chunks) + HEADER + b->used++ * b->slotSize;
+    }
+
+    /// @remark Complexite de O(1)
+    static void deallocate(Bucket* b, void* slot) noexcept {
+        *static_cast<void**>(slot) = b->freeList;
+        b->freeList = slot;
+    }
+
+    /// @remark Complexite de O(k), k etant le nombre de blocs
+    void release() noexcept {
+        for(Bucket* b = buckets; b; b = b->next) {
+            while(b->chunks) {
+                void* next = *static_cast<void**>(b->chunks);
+                ::operator delete(b->chunks);
+                b->chunks = next;
+            }
+            b->used = ChunkSize;
+            b->freeList = nullptr;
+        }
+    }
+};
+
+/**
+ * Allocateur par blocs pour les maillons : les objets sont pris dans des
+ * blocs contigus de ChunkSize emplacements, et les emplacements liberes sont
+ * recycles par une liste libre. release() rend tous les blocs d'un coup, en
+ * O(nombre de blocs), sans parcourir les objets.
+ *
+ * Les copies (et les conversions par rebind) partagent les memes blocs et
+ * sont egales entre elles : chacune peut rendre ce qu'une autre a alloue.
+ * Deux pools construits separement sont differents.
+ */
+template <typename T, size_t ChunkSize = 256>
+class NodePool {
+    static_assert(ChunkSize > 0, "NodePool : un bloc contient au moins un emplacement");
+    static_assert(alignof(T) <= alignof(max_align_t), "NodePool : alignement non supporte");
+
+    template <typename U, size_t C> friend class NodePool;
+
+    using Blocks = NodePoolBlocks<ChunkSize>;
+
+    /// Emplacement assez grand pour T ou pour le chainage de la liste libre, multiple des deux alignements
+    static const size_t SLOT_ALIGN = alignof(T) > alignof(void*) ? alignof(T) : alignof(void*);
+    static const size_t SLOT_SIZE = ((sizeof(T) > sizeof(void*) ? sizeof(T) : sizeof(void*)) + SLOT_ALIGN - 1)
+                                    / SLOT_ALIGN * SLOT_ALIGN;
+
+    shared_ptr<Blocks> blocks;
+    typename Blocks::Bucket* bucket;    // seau de SLOT_SIZE, trouve au premier allocate
+
+public:
+    using value_type = T;
 
-/// Classe de liste chainee
-template < typename T > class LinkedList {
+    template <typename U>
+    struct rebind {
+        using other = NodePool<U, ChunkSize>;
+    };
+
+    /**
+     *  @brief Nouveau pool, sans bloc
+     *
+     *  @exception std::bad_alloc si pas assez de memoire
+     */
+    NodePool() : blocks(make_shared<Blocks>()), bucket(nullptr) {
+    }
+
+    NodePool(const NodePool& other) noexcept : blocks(other.blocks), bucket(other.bucket) {
+    }
+
+    template <typename U>
+    NodePool(const NodePool<U, ChunkSize>& other) noexcept : blocks(other.blocks), bucket(nullptr) {
+    }
+
+    NodePool& operator = (const NodePool& other) noexcept {
+        blocks = other.blocks;
+        bucket = other.bucket;
+        return *this;
+    }
+
+    /**
+     *  @brief Emplacement pour n objets, pris dans les blocs si n vaut 1
+     *
+     *  @exception std::bad_alloc si pas assez de memoire
+     *
+     *  @remark Complexite de O(1)
+     */
+    T* allocate(size_t n) {
+        if(n != 1) {
+            return static_cast<T*>(::operator new(n * sizeof(T)));
+        }
+
+        if(!bucket) {
+            bucket = blocks->bucket(SLOT_SIZE);
+        }
+        return static_cast<T*>(Blocks::allocate(bucket));
+    }
+
+    /**
+     *  @brief Rend un emplacement, recycle par le prochain allocate
+     *
+     *  @remark Complexite de O(1)
+     */
+    void deallocate(T* p, size_t n) noexcept {
+        if(n != 1) {
+            ::operator delete(p);
+            return;
+        }
+
+        // p vient d'une copie egale : son seau est celui de SLOT_SIZE, deja cree
+        if(!bucket) {
+            bucket = blocks->bucket(SLOT_SIZE);
+        }
+        Blocks::deallocate(bucket, p);
+    }
+
+    /**
+     *  @brief Vrai si d'autres copies utilisent les memes blocs
+     */
+    bool shared() const noexcept {
+        return blocks.use_count() > 1;
+    }
+
+    /**
+     *  @brief Libere tous les blocs, sans detruire les objets qu'ils contiennent
+     *
+     *  Les objets alloues par toutes les copies sont perdus : a n'utiliser
+     *  que si aucune autre copie n'a d'objet vivant (voir shared()).
+     *
+     *  @remark Complexite de O(k), k etant le nombre de blocs
+     */
+    void release() noexcept {
+        blocks->release();
+    }
+
+    friend void swap(NodePool& a, NodePool& b) noexcept {
+        std::swap(a.blocks, b.blocks);
+        std::swap(a.bucket, b.bucket);
+    }
+
+    template <typename A, typename B, size_t C>
+    friend bool operator == (const NodePool<A, C>& a, const NodePool<B, C>& b) noexcept;
+};
+
+template <typename A, typename B, size_t C>
+bool operator == (const NodePool<A, C>& a, const NodePool<B, C>& b) noexcept {
+    return a.blocks == b.blocks;
+}
+
+template <typename A, typename B, size_t C>
+bool operator != (const NodePool<A, C>& a, const NodePool<B, C>& b) noexcept {
+    return !(a == b);
+}
+
+/// Forward declaration classe
+template < typename T, typename Trace = NoTrace, typename Alloc = allocator<T> > class LinkedList;
+
+/// Forward declaration fonction d'affichage
+template <typename T, typename Trace, typename Alloc>
+ostream& operator << (ostream& os, const LinkedList<T, Trace, Alloc>& liste);
+
+/**
+ * Classe de liste chainee
+ *
+ * Trace est une des politiques ci-dessus (ou toute classe offrant les memes
+ * fonctions statiques), appelee a chaque construction et destruction de maillon.
+ *
+ * Alloc est l'allocateur des maillons (reassocie au type Node), allocator<T>
+ * par defaut ou NodePool<T> pour des maillons contigus et liberes en bloc.
+ */
+template < typename T, typename Trace, typename Alloc > class LinkedList {
 
     /**
      * @brief Surcharge de l'operateur de flux (<size>: <element1> <element2> ...)
@@ -33,7 +318,7 @@ template < typename T > class LinkedList {
      *
      * @remark Complexite de O(n), n etant la taille de la liste
      */
-    friend ostream& operator << <T>(ostream& os, const LinkedList<T>& liste);
+    friend ostream& operator << <T, Trace, Alloc>(ostream& os, const LinkedList<T, Trace, Alloc>& liste);
 
 public:
     using value_type = T;
@@ -52,9 +337,10 @@ private:
         value_type data;
         Node* next;
 
-        Node(const_reference data, Node* next = nullptr)
-            : data(data), next(next) {
-                cout << "(C" << data << ") ";
+        template <typename... Args>
+        Node(Node* next, Args&&... args)
+            : data(std::forward<Args>(args)...), next(next) {
+                Trace::constructed(data);
             }
 
         Node(Node&) = delete;
@@ -62,29 +348,56 @@ private:
 
         ~Node()
         {
-            cout << "(D" << data << ") ";
+            Trace::destroyed(data);
         }
     };
 
+    using NodeAlloc = typename allocator_traits<Alloc>::template rebind_alloc<Node>;
+    using NodeTraits = allocator_traits<NodeAlloc>;
+
 private:
     /**
      *  @brief  Tete de la LinkedList
      */
     Node* head;
 
+private:
+    /**
+     *  @brief Emplacement du lien nul qui suit le dernier maillon (&head si vide)
+     */
+    Node** tail;
+
+private:
+    /**
+     *  @brief Allocateur des maillons
+     */
+    NodeAlloc alloc;
+
 private:
     /**
      *  @brief Nombre d'elements
      */
     size_t nbElements;
 
+private:
+    /**
+     *  @brief Curseur : derniere position resolue par locationAt et son emplacement
+     *
+     *  Toujours valide (au pire 0 et &head) : un acces a une position egale ou
+     *  posterieure reprend depuis lui au lieu de repartir de la tete. Seules
+     *  les fonctions non const le deplacent, les lectures concurrentes d'une
+     *  liste partagee restent donc sures.
+     */
+    size_t cursorPos;
+    Node** cursorLocation;
+
 public:
     /**
      *  @brief Constructeur par defaut. Construit une LinkedList vide
      *
      *  @remark Complexite de O(1)
      */
-    LinkedList() : head(nullptr), nbElements(0) {
+    LinkedList() : head(nullptr), tail(&head), alloc(), nbElements(0), cursorPos(0), cursorLocation(&head) {
     }
 
 public:
@@ -99,6 +412,24 @@ public:
         appendByCopy(other);
     }
 
+public:
+    /**
+     *  @brief Constructeur de deplacement
+     *
+     *  @param[in,out] other la LinkedList dont les maillons sont repris, vide ensuite
+     *
+     *  @remark Complexite de O(1)
+     */
+    LinkedList( LinkedList&& other ) noexcept
+        : head(other.head), tail(other.head ? other.tail : &head),
+          alloc(std::move(other.alloc)), nbElements(other.nbElements),
+          cursorPos(0), cursorLocation(&head) {
+        other.head = nullptr;
+        other.tail = &other.head;
+        other.nbElements = 0;
+        other.resetCursor();
+    }
+
 public:
     /**
      *  @brief Operateur d'affectation par copie
@@ -116,19 +447,55 @@ public:
      *  @remark Complexite de O(n), n etant la taille de la liste a copier
      */
     LinkedList& operator= ( const LinkedList& other ) {
-        if(head == other.head)
-            return *this;
-
-        LinkedList<T> tmp(other);
+        if(this != &other) {
+            LinkedList tmp(other);
+            swap(tmp);
+        }
 
-        swap(head, tmp.head);
-        swap(nbElements, tmp.nbElements);
+        return *this;
+    }
 
-        tmp.~LinkedList();
+public:
+    /**
+     *  @brief Operateur d'affectation par deplacement
+     *
+     *  @param[in,out] other la LinkedList dont les maillons sont repris, vide ensuite
+     *
+     *  @return la LinkedList courante *this (par reference)
+     *
+     *  @remark le contenu precedent de la LinkedList courante est
+     *           efface.
+     *
+     *  @remark Complexite de O(1), plus la liberation du contenu precedent
+     */
+    LinkedList& operator= ( LinkedList&& other ) noexcept {
+        LinkedList tmp(std::move(other));
+        swap(tmp);
 
         return *this;
     }
 
+public:
+    /**
+     *  @brief Echange du contenu (et des allocateurs) de deux LinkedList
+     *
+     *  @remark Complexite de O(1)
+     */
+    void swap( LinkedList& other ) noexcept {
+        using std::swap;
+        swap(head, other.head);
+        swap(tail, other.tail);
+        swap(nbElements, other.nbElements);
+        swap(alloc, other.alloc);
+
+        // Une liste vide designe sa propre tete
+        if(!head) tail = &head;
+        if(!other.head) other.tail = &other.head;
+
+        resetCursor();
+        other.resetCursor();
+    }
+
 public:
     /**
      *  @brief destructeur
@@ -136,8 +503,22 @@ public:
      *  @remark Complexite de O(n), n etant la taille de la liste a copier
      */
     ~LinkedList() {
+        clear();
+    }
+
+public:
+    /**
+     *  @brief Suppression de tous les elements
+     *
+     *  @remark Complexite de O(n), n etant la taille de la liste ; avec un
+     *          allocateur par blocs (release()), de O(k), k etant le nombre
+     *          de blocs, si les maillons n'ont rien a faire a leur destruction
+     */
+    void clear() noexcept {
+        releaseAll(alloc, 0);
         while(head)
             removeNode(&head);
+        resetCursor();
     }
 
 public:
@@ -163,8 +544,151 @@ public:
      *  @remark Complexite de O(1)
      */
     void push_front( const_reference value) {
-        head = new Node(value, head);
-        ++nbElements;
+        emplace_front(value);
+    }
+
+    /**
+     *  @brief insertion d'une valeur deplacee dans un maillon en tête de liste
+     *
+     *  @param[in,out] value la valeur a deplacer
+     *
+     *  @exception std::bad_alloc si pas assez de memoire, où toute autre exception lancee par la constructeur de deplacement de value_type
+     *
+     *  @remark Complexite de O(1)
+     */
+    void push_front( value_type&& value) {
+        emplace_front(std::move(value));
+    }
+
+public:
+    /**
+     *  @brief construction d'une valeur directement dans un maillon en tête de liste
+     *
+     *  @param[in] args arguments transmis au constructeur de value_type
+     *
+     *  @exception std::bad_alloc si pas assez de memoire, où toute autre exception lancee par la constructeur de value_type
+     *
+     *  @remark Complexite de O(1)
+     */
+    template <typename... Args>
+    void emplace_front( Args&&... args ) {
+        emplaceAt(&head, std::forward<Args>(args)...);
+        if(cursorPos > 0) {
+            ++cursorPos; // meme emplacement, une position plus loin
+        }
+    }
+
+public:
+    /**
+     *  @brief insertion d'une valeur dans un maillon en queue de liste
+     *
+     *  @param[in] value la valeur a inserer
+     *
+     *  @exception std::bad_alloc si pas assez de memoire, où toute autre exception lancee par la constructeur de copie de value_type
+     *
+     *  @remark Complexite de O(1)
+     */
+    void push_back( const_reference value) {
+        emplace_back(value);
+    }
+
+    /**
+     *  @brief insertion d'une valeur deplacee dans un maillon en queue de liste
+     *
+     *  @param[in,out] value la valeur a deplacer
+     *
+     *  @exception std::bad_alloc si pas assez de memoire, où toute autre exception lancee par la constructeur de deplacement de value_type
+     *
+     *  @remark Complexite de O(1)
+     */
+    void push_back( value_type&& value) {
+        emplace_back(std::move(value));
+    }
+
+public:
+    /**
+     *  @brief construction d'une valeur directement dans un maillon en queue de liste
+     *
+     *  @param[in] args arguments transmis au constructeur de value_type
+     *
+     *  @exception std::bad_alloc si pas assez de memoire, où toute autre exception lancee par la constructeur de value_type
+     *
+     *  @remark Complexite de O(1)
+     */
+    template <typename... Args>
+    void emplace_back( Args&&... args ) {
+        emplaceAt(tail, std::forward<Args>(args)...);
+    }
+
+public:
+    /**
+     *  @brief Deplacement de tous les maillons de other en queue de liste
+     *
+     *  @param[in,out] other la LinkedList dont les maillons sont repris, vide ensuite
+     *
+     *  @exception std::bad_alloc si les allocateurs different (les valeurs sont
+     *              alors deplacees dans de nouveaux maillons), où toute autre exception
+     *              lancee par la constructeur de deplacement de value_type
+     *
+     *  @remark Complexite de O(1) si les allocateurs sont egaux, O(m) sinon,
+     *          m etant la taille de other
+     */
+    void splice( LinkedList& other ) {
+        if(this == &other || !other.head) {
+            return;
+        }
+
+        if(alloc != other.alloc) {
+            for(Node* node = other.head; node; node = node->next) {
+                emplace_back(std::move(node->data));
+            }
+            other.clear();
+            return;
+        }
+
+        *tail = other.head;
+        tail = other.tail;
+        nbElements += other.nbElements;
+
+        other.head = nullptr;
+        other.tail = &other.head;
+        other.nbElements = 0;
+        other.resetCursor();
+    }
+
+    void splice( LinkedList&& other ) {
+        splice(other);
+    }
+
+public:
+    /**
+     *  @brief Copie des elements d'une autre liste en queue de liste
+     *
+     *  @param[in] other la LinkedList a copier, eventuellement la liste courante
+     *
+     *  @exception std::bad_alloc si pas assez de memoire, où toute autre exception lancee
+     *              par la constructeur de copie de value_type
+     *
+     *  @remark Complexite de O(m), m etant la taille de other
+     */
+    void append( const LinkedList& other ) {
+        appendByCopy(other, nbElements);
+    }
+
+    /**
+     *  @brief Copie des elements de [first, last) en queue de liste
+     *
+     *  @param[in] first debut de l'intervalle
+     *  @param[in] last  fin de l'intervalle (exclue)
+     *
+     *  @exception std::bad_alloc si pas assez de memoire, où toute autre exception lancee
+     *              par la constructeur de value_type
+     *
+     *  @remark Complexite de O(m), m etant la taille de l'intervalle
+     */
+    template <typename InputIt>
+    void append( InputIt first, InputIt last ) {
+        appendByCopy(first, last, nbElements);
     }
 
 public:
@@ -202,6 +726,13 @@ public:
         }
 
         removeNode(&head);
+
+        // L'emplacement de la position 1 etait dans le maillon supprime
+        if(cursorPos == 1) {
+            resetCursor();
+        } else if(cursorPos > 1) {
+            --cursorPos;
+        }
     }
 
 public:
@@ -219,17 +750,46 @@ public:
      *  @remark Complexite de O(n), n etant la taille de la liste
      */
     void insert( const_reference value, size_t pos ) {
-        if(pos == 0)
-            return push_front(value);
+        emplace(pos, value);
+    }
+
+    /**
+     *  @brief Insertion d'une valeur deplacee en position quelconque
+     *
+     *  @param[in,out] value la valeur a deplacer
+     *  @param[in] pos       la position où inserer, 0 est la position en tete
+     *
+     *  @exception std::out_of_range("LinkedList::insert") si pos non valide
+     *
+     *  @exception std::bad_alloc si pas assez de memoire, où toute autre exception lancee
+     *              par la constructeur de deplacement de value_type
+     *
+     *  @remark Complexite de O(n), n etant la taille de la liste
+     */
+    void insert( value_type&& value, size_t pos ) {
+        emplace(pos, std::move(value));
+    }
 
+public:
+    /**
+     *  @brief Construction d'une valeur directement en position quelconque
+     *
+     *  @param[in] pos  la position où inserer, 0 est la position en tete
+     *  @param[in] args arguments transmis au constructeur de value_type
+     *
+     *  @exception std::out_of_range("LinkedList::insert") si pos non valide
+     *
+     *  @exception std::bad_alloc si pas assez de memoire, où toute autre exception lancee
+     *              par la constructeur de value_type
+     *
+     *  @remark Complexite de O(n), n etant la taille de la liste ; O(1) en tete et en queue
+     */
+    template <typename... Args>
+    void emplace( size_t pos, Args&&... args ) {
         if(!isValidLocationPos(pos))
             throw std::out_of_range("LinkedList::insert");
 
-        Node** tmp = locationAt(pos);
-
-        *tmp = new Node(value, (*tmp));
-
-        nbElements++;
+        emplaceAt(pos == nbElements ? tail : locationAt(pos), std::forward<Args>(args)...);
     }
 
 public:
@@ -242,7 +802,8 @@ public:
      *
      *  @return une reference a l'element correspondant dans la liste
      *
-     *  @remark Complexite de O(n), n etant la taille de la liste
+     *  @remark Complexite de O(n), n etant la taille de la liste ; O(1) amorti
+     *          pour un parcours par positions croissantes
      */
     reference at( size_t pos ) {
         if(!isValidElementPos(pos))
@@ -260,10 +821,16 @@ public:
      *
      *  @return une const_reference a l'element correspondant dans la liste
      *
-     *  @remark Complexite de O(n), n etant la taille de la liste
+     *  @remark ne deplace pas le curseur : deux lectures concurrentes sont sures
+     *
+     *  @remark Complexite de O(n), n etant la taille de la liste ; O(pos - curseur)
+     *          si pos est au moins la position du curseur
      */
     const_reference at( size_t pos ) const {
-        return static_cast<const_reference>(const_cast<LinkedList*>(this)->at(pos));
+        if(!isValidElementPos(pos))
+            throw std::out_of_range("LinkedList::at");
+
+        return (*locationAt(pos))->data;
     }
 
 public:
@@ -314,12 +881,81 @@ public:
     }
 
     /**
-     *  @brief Tri des elements de la liste par tri fusion
-     *  
-     *  @remark Complexite de O(n*log(n)), n etant la taille de la liste
+     *  @brief Tri stable des elements de la liste par tri fusion naturel
+     *
+     *  Iteratif et ascendant : la liste est decoupee en sequences deja
+     *  croissantes (ou strictement decroissantes, retournees), fusionnees au
+     *  fil de l'eau dans des casiers ou le casier i regroupe environ 2^i
+     *  sequences, comme le fait std::list::sort. Chaque sequence garde son
+     *  dernier maillon : aucun segment fusionne n'est reparcouru.
+     *
+     *  @remark Complexite de O(n*log(r)), n etant la taille de la liste et r
+     *          le nombre de sequences ; O(n) si la liste est deja triee
      */
     void sort() noexcept {
-        mergeSort(&head, nbElements);
+        Run sorted = sortChain(head);
+
+        head = sorted.first;
+        tail = sorted.last ? &sorted.last->next : &head;
+        resetCursor();
+    }
+
+    /**
+     *  @brief Tri stable des elements de la liste sur plusieurs threads
+     *
+     *  La liste est coupee en nbThreads segments contigus, chacun trie par
+     *  son propre thread comme dans sort(), puis les segments sont fusionnes
+     *  deux a deux, les fusions d'un meme tour en parallele. Les maillons
+     *  sont seulement rechaines : ni copie de valeurs, ni allocation de
+     *  maillons. Si un thread ne peut etre cree, son travail est fait par
+     *  le thread appelant.
+     *
+     *  @param[in] nbThreads nombre de segments, borne par MAX_THREADS et pour
+     *              que chaque segment compte au moins PARALLEL_GRAIN elements ;
+     *              en dessous de 2, equivaut a sort()
+     *
+     *  @remark Complexite de O(n*log(n) / p + n), n etant la taille de la
+     *          liste et p le nombre de threads
+     */
+    void parallel_sort( size_t nbThreads = thread::hardware_concurrency() ) noexcept {
+        // Bornes comparees directement : min() prendrait l'adresse des constantes
+        if(nbThreads > MAX_THREADS) nbThreads = MAX_THREADS;
+        if(nbThreads > nbElements / PARALLEL_GRAIN) nbThreads = nbElements / PARALLEL_GRAIN;
+        if(nbThreads < 2) {
+            return sort();
+        }
+
+        Run segments[MAX_THREADS];
+        Node* rest = head;
+        for(size_t i = 0; i < nbThreads; i++) {
+            size_t length = nbElements / nbThreads + (i < nbElements % nbThreads ? 1 : 0);
+            Node* last = rest;
+            for(size_t k = 1; k < length; k++) {
+                last = last->next;
+            }
+
+            segments[i].first = rest;
+            rest = last->next;
+            last->next = nullptr;
+        }
+
+        runParallel(nbThreads, [&segments](size_t i) {
+            segments[i] = sortChain(segments[i].first);
+        });
+
+        // Le segment de gauche precede toujours celui de droite : fusion stable
+        for(size_t width = 1; width < nbThreads; width *= 2) {
+            runParallel((nbThreads + 2 * width - 1) / (2 * width), [&segments, width, nbThreads](size_t pair) {
+                size_t left = 2 * width * pair;
+                if(left + width < nbThreads) {
+                    segments[left] = merge(segments[left], segments[left + width]);
+                }
+            });
+        }
+
+        head = segments[0].first;
+        tail = &segments[0].last->next;
+        resetCursor();
     }
 
 private:
@@ -349,49 +985,140 @@ private:
      *
      * @return Adresse du noeud voulu
      *
-     * @remark Complexite de O(n), n etant la taille de la liste
+     * @remark Complexite de O(n), n etant la taille de la liste ; O(pos - cursorPos)
+     *          si pos est au moins la position du curseur
      *
-     * Fonction pure qui ne test pas les valeurs d'entrés, il est nécessaire
-     *  que les testes soit effecutés en amont
+     * Fonction qui ne test pas les valeurs d'entrés, il est nécessaire
+     *  que les testes soit effecutés en amont. Le curseur est place sur pos :
+     *  une insertion ou une suppression a cette position le laisse valide.
      */
     Node** locationAt( size_t pos ) noexcept {
         assert(pos <= nbElements);
 
-        Node** current = &head;
+        if(pos < cursorPos) {
+            resetCursor();
+        }
+
+        Node** current = cursorLocation;
+
+        for(size_t i = cursorPos; i < pos; i++){
+            current = &((*current)->next);
+        }
+
+        cursorPos = pos;
+        cursorLocation = current;
+
+        return current;
+    }
+
+    /**
+     * @brief Recuperation de l'emplacement d'une position, sans deplacer le curseur
+     *
+     * @param[in] pos Position de l'emplacement entre 0 et nbElements
+     *
+     * @return Adresse du noeud voulu
+     *
+     * @remark Complexite de O(n), n etant la taille de la liste ; O(pos - cursorPos)
+     *          si pos est au moins la position du curseur
+     */
+    Node* const* locationAt( size_t pos ) const noexcept {
+        assert(pos <= nbElements);
+
+        size_t i = 0;
+        Node* const* current = &head;
+        if(pos >= cursorPos) {
+            i = cursorPos;
+            current = cursorLocation;
+        }
 
-        for(size_t i = 0; i < pos; i++){
+        for(; i < pos; i++){
             current = &((*current)->next);
         }
 
         return current;
     }
+
+    /**
+     * @brief Replace le curseur en tete, apres une modification qui l'invalide
+     *
+     * @remark Complexite de O(1)
+     */
+    void resetCursor() noexcept {
+        cursorPos = 0;
+        cursorLocation = &head;
+    }
     /**
      * @brief Copie d'une liste a partir de la position voulu
      *
-     * @param[in] other Liste a copier integralement
+     * @param[in] other Liste a copier integralement, eventuellement la liste courante
      *
      * @param[in] pos Position de depart de la copie
      *
      * @exception En provenance de locationAt si pos non valide
      * 
      * @exception std::bad_alloc si pas assez de memoire, où toute autre exception lancee
-     *              par le constructeur de copie de value_type
+     *              par le constructeur de copie de value_type ; les elements deja
+     *              copies restent alors dans la liste
      *
-     * @remark Complexite de O(n), n etant la taille de la liste a copie
+     * @remark Complexite de O(n), n etant la taille de la liste a copie ; plus
+     *          O(pos) sauf en queue de liste
      */
     void appendByCopy( const LinkedList& other, size_t pos = 0 ) {
-        Node** target = locationAt(pos);
-        Node* end = *target;
+        Node** target = pos == nbElements ? tail : locationAt(pos);
         Node* source = other.head;
 
-        while (source) {
-            *target = new Node(source->data);
+        // Nombre fixe a l'avance : other peut etre la liste courante
+        for(size_t n = other.nbElements; n > 0; --n) {
+            emplaceAt(target, source->data);
             target = &(*target)->next;
             source = source->next;
         }
+    }
 
-        *target = end; //Rechainage du reste
-        nbElements += other.nbElements;
+    /**
+     * @brief Copie des elements de [first, last) a partir de la position pos
+     *
+     * @param[in] first debut de l'intervalle
+     * @param[in] last  fin de l'intervalle (exclue)
+     * @param[in] pos   Position de depart de la copie
+     *
+     * @exception En provenance de locationAt si pos non valide
+     *
+     * @exception std::bad_alloc si pas assez de memoire, où toute autre exception lancee
+     *              par le constructeur de value_type ; les elements deja
+     *              copies restent alors dans la liste
+     *
+     * @remark Complexite de O(m), m etant la taille de l'intervalle ; plus
+     *          O(pos) sauf en queue de liste
+     */
+    template <typename InputIt>
+    void appendByCopy( InputIt first, InputIt last, size_t pos ) {
+        Node** target = pos == nbElements ? tail : locationAt(pos);
+
+        for(; first != last; ++first) {
+            emplaceAt(target, *first);
+            target = &(*target)->next;
+        }
+    }
+
+    /**
+     * @brief Construction d'un maillon a un emplacement, devant celui qui s'y trouve
+     *
+     * @param[in] location emplacement ou chainer le nouveau maillon
+     * @param[in] args     arguments transmis au constructeur de value_type
+     *
+     * @exception std::bad_alloc si pas assez de memoire, où toute autre exception lancee
+     *              par le constructeur de value_type
+     *
+     * @remark Complexite de O(1)
+     */
+    template <typename... Args>
+    void emplaceAt( Node** location, Args&&... args ) {
+        *location = newNode(*location, std::forward<Args>(args)...);
+        if(location == tail) {
+            tail = &(*location)->next;
+        }
+        ++nbElements;
     }
     
     /**
@@ -409,85 +1136,273 @@ private:
 
         Node* tmp = *target;
         *target = (*target)->next;
-        delete tmp;
+        if(tail == &tmp->next) {
+            tail = target;
+        }
+        deleteNode(tmp);
 
         --nbElements;
     }
 
     /**
-     * @brief Trie par fusion
+     * @brief Construction d'un maillon avec l'allocateur de la liste
      *
-     * @param[in] start Pointeur de pointeur sur un noeud de depart du trie
-     * @param[in] size Taille de la liste
+     * @param[in] next maillon suivant
+     * @param[in] args arguments transmis au constructeur de value_type
      *
-     * @return Emplacement de la fin de la chaine
+     * @exception std::bad_alloc si pas assez de memoire, où toute autre exception lancee
+     *              par le constructeur de value_type
      *
-     * @remark Complexite de O(n*log(n)), n etant la taille de la liste
-     *          pour l'ensemble du trie
+     * @remark Complexite de O(1)
      */
-    Node** mergeSort( Node** start, size_t size ) noexcept {
-        if(size == 0) return start;
-        if(size == 1) return &(*start)->next;
+    template <typename... Args>
+    Node* newNode( Node* next, Args&&... args ) {
+        Node* node = NodeTraits::allocate(alloc, 1);
+        try {
+            NodeTraits::construct(alloc, node, next, std::forward<Args>(args)...);
+        } catch(...) {
+            NodeTraits::deallocate(alloc, node, 1);
+            throw;
+        }
+        return node;
+    }
 
-        Node** half = mergeSort(start, size / 2); //trie sur la moitie gauche
-        Node** end  = mergeSort(half,size - size / 2); //trie sur la moitie droite
+    /**
+     * @brief Destruction d'un maillon construit par newNode
+     *
+     * @remark Complexite de O(1)
+     */
+    void deleteNode( Node* node ) noexcept {
+        NodeTraits::destroy(alloc, node);
+        NodeTraits::deallocate(alloc, node, 1);
+    }
+
+    /**
+     * @brief Liberation en bloc des maillons, si l'allocateur le permet
+     *
+     * Les maillons sont detruits un a un seulement si leur destruction a un
+     * effet (valeur non triviale ou trace), puis tous les blocs sont rendus.
+     *
+     * @remark Complexite de O(k) (k blocs) ou O(n + k)
+     */
+    template <typename A>
+    auto releaseAll( A& allocator, int ) noexcept -> decltype(allocator.release(), allocator.shared(), void()) {
+        // Blocs partages avec une autre liste : les maillons sont rendus un a un par clear
+        if(allocator.shared()) {
+            return;
+        }
+        if(!is_trivially_destructible<value_type>::value || !is_same<Trace, NoTrace>::value) {
+            for(Node* node = head; node;) {
+                Node* next = node->next;
+                NodeTraits::destroy(allocator, node);
+                node = next;
+            }
+        }
+        allocator.release();
+        head = nullptr;
+        tail = &head;
+        resetCursor();
+        nbElements = 0;
+    }
 
-        return merge(start, *half, *end);
+    /// Allocateur sans liberation en bloc : les maillons sont rendus un a un par clear
+    template <typename A>
+    void releaseAll( A&, long ) noexcept {
     }
 
     /**
-     * @brief Fonction de fusion du trie par fusion
+     * @brief Longueur minimale d'une sequence avant fusion
+     */
+    static const size_t MIN_RUN = 16;
+
+    /**
+     * @brief Sequence triee de maillons, terminee par nullptr
+     */
+    struct Run {
+        Node* first;
+        Node* last;
+    };
+
+    /**
+     * @brief Tri d'une chaine de maillons terminee par nullptr
      *
-     * @param[in] start pointeur de pointeur sur le depart de la liste
-     * @param[in] half  pointeur sur le noeud du milieu
-     * @param[in] end   pointeur sur le noeud de fin (hors fusion)
+     * Iteratif et ascendant, voir sort() ; n'utilise aucun membre de la
+     * liste, et peut donc trier plusieurs chaines en parallele.
      *
-     * @return l'emplacement memoire du dernier noeud (hors fusion)
+     * @param[in] first premier maillon de la chaine
      *
-     * @remark Complexite de O(n), n étant la taille de la liste
+     * @return la chaine triee et son dernier maillon
+     *
+     * @remark Complexite de O(n*log(r)), n etant la taille de la chaine et r
+     *          le nombre de sequences
      */
-    Node** merge( Node** start, Node* half, Node* end ) noexcept {
-        Node*  first   = *start, // sentinelle gauche
-            *  second  = half,   // sentinelle droite
-            ** current = start;
+    static Run sortChain( Node* first ) noexcept {
+        Run bins[sizeof(size_t) * 8] = {};
+        const size_t nbBins = sizeof(bins) / sizeof(bins[0]);
+        size_t used = 0;
+
+        for(Node* rest = first; rest;) {
+            Run run = nextRun(rest);
+
+            // Propagation comme une retenue : les casiers pleins contiennent des elements anterieurs
+            size_t i = 0;
+            for(; i < used && bins[i].first; i++) {
+                run = merge(bins[i], run);
+                bins[i].first = nullptr;
+            }
+            if(i == nbBins) {
+                --i;
+            }
+            bins[i] = run;
+            if(i == used) {
+                ++used;
+            }
+        }
 
-        // Trie des valeurs par rapport au deux sentinelles
-        while(first != half && second != end){
-            if(first->data < second->data){
-                *current = first;
-                first = first->next;
-            } else {
-                *current = second;
-                second = second->next;
+        Run sorted = { nullptr, nullptr };
+        for(size_t i = 0; i < used; i++) {
+            if(bins[i].first) {
+                sorted = sorted.first ? merge(bins[i], sorted) : bins[i];
             }
+        }
 
-            current = &(*current)->next;
+        return sorted;
+    }
+
+    /**
+     * @brief Execute task(0) ... task(count - 1), task(0) dans le thread
+     *        appelant et les autres chacune dans un thread
+     *
+     * @remark un thread qui ne peut etre cree est remplace par un appel direct
+     */
+    template <typename Task>
+    static void runParallel( size_t count, const Task& task ) noexcept {
+        assert(count <= MAX_THREADS);
+
+        thread workers[MAX_THREADS];
+        for(size_t i = 1; i < count; i++) {
+            try {
+                workers[i] = thread(task, i);
+            } catch(...) {
+                task(i);
+            }
         }
 
-        // Recopie du reste lorsqu'une sentinelle
-        // arrive a la fin
-        Node* target;
-        if(first == half){
-            *current = second;
-            target = end;
+        task(0);
+
+        for(size_t i = 1; i < count; i++) {
+            if(workers[i].joinable()) {
+                workers[i].join();
+            }
+        }
+    }
+
+    /**
+     * @brief Nombre maximal de threads de parallel_sort
+     */
+    static const size_t MAX_THREADS = 64;
+
+    /**
+     * @brief Nombre minimal d'elements par thread de parallel_sort
+     */
+    static const size_t PARALLEL_GRAIN = 4096;
+
+    /**
+     * @brief Detache la plus longue sequence croissante (ou strictement
+     *        decroissante, alors retournee) en tete de rest, completee par
+     *        insertion jusqu'a MIN_RUN maillons
+     *
+     * @param[in,out] rest premier maillon non encore traite, avance apres la sequence
+     *
+     * @return la sequence, dans l'ordre croissant
+     *
+     * @remark Complexite de O(k + MIN_RUN^2), k etant la longueur de la sequence
+     */
+    static Run nextRun( Node*& rest ) noexcept {
+        Run run = { rest, rest };
+        Node* next = rest->next;
+        size_t length = 1;
+
+        if(next && next->data < rest->data) {
+            // Strictement decroissante : retournee au fur et a mesure, ce qui reste stable
+            while(next && next->data < run.first->data) {
+                Node* after = next->next;
+                next->next = run.first;
+                run.first = next;
+                next = after;
+                ++length;
+            }
+        } else {
+            while(next && !(next->data < run.last->data)) {
+                run.last = next;
+                next = next->next;
+                ++length;
+            }
         }
-        else{
-            *current = first;
-            target = half;
+        run.last->next = nullptr;
+
+        // Sequence trop courte (donnees aleatoires) : completee par insertion,
+        // sur des maillons encore proches en memoire
+        for(; next && length < MIN_RUN; ++length) {
+            Node* node = next;
+            next = next->next;
+
+            if(!(node->data < run.last->data)) {
+                run.last->next = node;
+                run.last = node;
+                node->next = nullptr;
+            } else {
+                Node** location = &run.first;
+                while(!(node->data < (*location)->data)) {
+                    location = &(*location)->next;
+                }
+                node->next = *location;
+                *location = node;
+            }
         }
 
-        while ((*current)->next != target)
+        rest = next;
+        return run;
+    }
+
+    /**
+     * @brief Fusion stable de deux sequences triees
+     *
+     * @param[in] left  sequence dont les elements precedent ceux de right dans la liste
+     * @param[in] right sequence suivante
+     *
+     * @return la sequence fusionnee
+     *
+     * @remark Complexite de O(k), k etant le nombre de maillons comparés ; le
+     *          reste de la sequence non epuisee est rechaine sans parcours
+     */
+    static Run merge( Run left, Run right ) noexcept {
+        Node*  first   = left.first,
+            *  second  = right.first,
+            *  merged  = nullptr,
+            ** current = &merged;
+
+        while(first && second) {
+            if(second->data < first->data) {
+                *current = second;
+                second = second->next;
+            } else {
+                *current = first;
+                first = first->next;
+            }
+
             current = &(*current)->next;
+        }
 
-        // Remet la fin correct
-        (*current)->next = end;
+        *current = first ? first : second;
 
-        return &(*current)->next;
+        Run run = { merged, first ? left.last : right.last };
+        return run;
     }
 };
 
-template <typename T>
-ostream& operator << ( ostream& os, const LinkedList<T>& liste ) {
+template <typename T, typename Trace, typename Alloc>
+ostream& operator << ( ostream& os, const LinkedList<T, Trace, Alloc>& liste ) {
     os << liste.size() << ": ";
     auto n = liste.head;
 
@@ -498,3 +1413,5 @@ ostream& operator << ( ostream& os, const LinkedList<T>& liste ) {
 
     return os;
 }
+
+#endif
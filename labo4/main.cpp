@@ -1,11 +1,14 @@
 #include "linked_list.cpp"
 
+// Les maillons sont traces sur cout : (C...) a la creation, (D...) a la destruction
+typedef LinkedList<int, StreamTrace> Liste;
+
 int main() {
 
     const int N = 10;
 
     cout << "Creation d'une liste de " << N << " entiers aléatoires \n";
-    LinkedList<int> liste;
+    Liste liste;
     for (unsigned i = 0; i < N; ++i) {
         liste.push_front(rand()%100);
     }
@@ -39,7 +42,7 @@ int main() {
 
     {
         cout << "\nCopie d0une liste constant\n";
-        const LinkedList<int> test(liste);
+        const Liste test(liste);
         cout << "\n" << test;
 
         cout << "\n Recupération d'un element\n";
@@ -49,7 +52,7 @@ int main() {
     }
     {
         cout << "\nCopie d'une liste constant\n";
-        LinkedList<int> liste2(liste);
+        Liste liste2(liste);
         cout << "\n" << liste2;
         cout << "\nSuppression des 4 premiers éléments\n";
         liste2.erase(0);
@@ -84,14 +87,14 @@ int main() {
     }
 
     try{
-        LinkedList<int> test;
+        Liste test;
         test.front();
     } catch (const std::exception& e) {
         cout << e.what() << endl;
     }
 
     try{
-        LinkedList<int> test;
+        Liste test;
         test.pop_front();
     } catch (const std::exception& e) {
         cout << e.what() << endl;
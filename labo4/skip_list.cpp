@@ -0,0 +1,685 @@
+//
+//  SkipList.cpp
+//
+//  Jonathan Zaehringer
+//  Jorge-Andre Fulgencio Esteves
+//  Florian Schaufelberger
+//
+
+#ifndef _SKIP_LIST_CPP_
+#define _SKIP_LIST_CPP_
+
+#include <iostream>
+#include <stdexcept>
+#include <cassert>
+#include <cstdint>
+#include <new>
+#include <utility>
+
+#include "linked_list.cpp"
+
+/// Forward declaration classe
+template < typename T, typename Trace = NoTrace > class SkipList;
+
+/// Forward declaration fonction d'affichage
+template <typename T, typename Trace>
+ostream& operator << (ostream& os, const SkipList<T, Trace>& liste);
+
+/**
+ * Liste a acces par position en O(log n), meme interface que LinkedList
+ *
+ * Liste a enjambements (skip list) indexable : chaque maillon porte une tour
+ * de liens de hauteur aleatoire (p = 1/4), et chaque lien retient le nombre
+ * de positions qu'il enjambe. at, insert et erase descendent la tour de la
+ * tete en sommant ces longueurs : O(log n) en moyenne au lieu de O(n).
+ *
+ * Un lien nul enjambe toutes les positions jusqu'a la fin de la liste.
+ */
+template < typename T, typename Trace > class SkipList {
+
+    /**
+     * @brief Surcharge de l'operateur de flux (<size>: <element1> <element2> ...)
+     *
+     * @param[in,out] os flux de sortie utilise par l'envoi
+     * @param[in] liste SkipList a afficher
+     *
+     * @return flux de sortie recu pour chainage
+     *
+     * @remark Complexite de O(n), n etant la taille de la liste
+     */
+    friend ostream& operator << <T, Trace>(ostream& os, const SkipList<T, Trace>& liste);
+
+public:
+    using value_type = T;
+    using reference = T&;
+    using const_reference = const T&;
+    using pointer = T*;
+    using const_pointer = const T*;
+
+private:
+    /**
+     *  @brief Hauteur maximale d'une tour, suffisante pour 4^32 elements
+     */
+    static const int MAX_LEVEL = 32;
+
+    struct Node;
+
+    /**
+     *  @brief Lien d'un etage : maillon suivant et nombre de positions enjambees
+     */
+    struct Link {
+        Node* next;
+        size_t span;
+    };
+
+    /**
+     *  @brief Maillon de la chaine.
+     *
+     * contient une valeur et sa tour de liens, allouee juste apres le maillon.
+     */
+    struct Node {
+        value_type data;
+        int height;
+
+        template <typename... Args>
+        Node(int height, Args&&... args)
+            : data(std::forward<Args>(args)...), height(height) {
+                Trace::constructed(data);
+            }
+
+        Node(Node&) = delete;
+        Node(Node&&) = delete;
+
+        ~Node()
+        {
+            Trace::destroyed(data);
+        }
+
+        /// Debut de la tour : fin du maillon arrondie a l'alignement des liens
+        static constexpr size_t linksOffset() noexcept {
+            return (sizeof(Node) + alignof(Link) - 1) / alignof(Link) * alignof(Link);
+        }
+
+        Link* links() noexcept {
+            return reinterpret_cast<Link*>(reinterpret_cast<char*>(this) + linksOffset());
+        }
+
+        Node* next() noexcept {
+            return links()[0].next;
+        }
+    };
+
+private:
+    /**
+     *  @brief Tour de la tete, un lien par etage
+     */
+    Link head[MAX_LEVEL];
+
+private:
+    /**
+     *  @brief Nombre d'etages utilises
+     */
+    int levels;
+
+private:
+    /**
+     *  @brief Nombre d'elements
+     */
+    size_t nbElements;
+
+private:
+    /**
+     *  @brief Etat du generateur des hauteurs (xorshift)
+     */
+    uint64_t seed;
+
+public:
+    /**
+     *  @brief Constructeur par defaut. Construit une SkipList vide
+     *
+     *  @remark Complexite de O(1)
+     */
+    SkipList() : levels(1), nbElements(0), seed(uint64_t(reinterpret_cast<uintptr_t>(this)) | 1) {
+        for(Link& link : head) {
+            link.next = nullptr;
+            link.span = 0;
+        }
+    }
+
+public:
+    /**
+     *  @brief Constructeur de copie
+     *
+     *  @param[in] other la SkipList a copier
+     *
+     *  @remark Complexite de O(n), n etant la taille de la liste a copier
+     */
+    SkipList( const SkipList& other ) : SkipList() {
+        Link* last = head;
+        for(Node* source = other.head[0].next; source; source = source->next()) {
+            last->next = newNode(randomHeight(), source->data);
+            last = last->next->links();
+            last->next = nullptr;
+            ++nbElements;
+        }
+        relink();
+    }
+
+public:
+    /**
+     *  @brief Constructeur de deplacement
+     *
+     *  @param[in,out] other la SkipList dont les maillons sont repris, vide ensuite
+     *
+     *  @remark Complexite de O(log n)
+     */
+    SkipList( SkipList&& other ) noexcept : SkipList() {
+        swap(other);
+    }
+
+public:
+    /**
+     *  @brief Operateur d'affectation par copie
+     *
+     *  @param[in] other la SkipList a copier
+     *
+     *  @return la SkipList courante *this (par reference)
+     *
+     *  @remark Complexite de O(n), n etant la taille de la liste a copier
+     */
+    SkipList& operator= ( const SkipList& other ) {
+        if(this != &other) {
+            SkipList tmp(other);
+            swap(tmp);
+        }
+
+        return *this;
+    }
+
+    /**
+     *  @brief Operateur d'affectation par deplacement
+     *
+     *  @param[in,out] other la SkipList dont les maillons sont repris, vide ensuite
+     *
+     *  @return la SkipList courante *this (par reference)
+     *
+     *  @remark Complexite de O(log n), plus la liberation du contenu precedent
+     */
+    SkipList& operator= ( SkipList&& other ) noexcept {
+        SkipList tmp(std::move(other));
+        swap(tmp);
+
+        return *this;
+    }
+
+public:
+    /**
+     *  @brief Echange du contenu de deux SkipList
+     *
+     *  @remark Complexite de O(log n), les tours de tete etant recopiees
+     */
+    void swap( SkipList& other ) noexcept {
+        using std::swap;
+        int top = levels > other.levels ? levels : other.levels;
+        for(int i = 0; i < top; i++) {
+            swap(head[i], other.head[i]);
+        }
+        swap(levels, other.levels);
+        swap(nbElements, other.nbElements);
+    }
+
+public:
+    /**
+     *  @brief destructeur
+     *
+     *  @remark Complexite de O(n), n etant la taille de la liste
+     */
+    ~SkipList() {
+        clear();
+    }
+
+public:
+    /**
+     *  @brief Suppression de tous les elements
+     *
+     *  @remark Complexite de O(n), n etant la taille de la liste
+     */
+    void clear() noexcept {
+        Node* node = head[0].next;
+        while(node) {
+            Node* next = node->next();
+            deleteNode(node);
+            node = next;
+        }
+
+        levels = 1;
+        head[0].next = nullptr;
+        head[0].span = 0;
+        nbElements = 0;
+    }
+
+public:
+    /**
+     *  @brief nombre d'elements stockes dans la liste
+     *
+     *  @return nombre d'elements.
+     *
+     *  @remark Complexite de O(1)
+     */
+    size_t size() const noexcept {
+        return nbElements;
+    }
+
+public:
+    /**
+     *  @brief insertion d'une valeur en tête de liste
+     *
+     *  @param[in] value la valeur a inserer
+     *
+     *  @exception std::bad_alloc si pas assez de memoire, où toute autre exception lancee par la constructeur de copie de value_type
+     *
+     *  @remark Complexite de O(log n) en moyenne
+     */
+    void push_front( const_reference value ) {
+        insert(value, 0);
+    }
+
+    /**
+     *  @brief insertion d'une valeur en queue de liste
+     *
+     *  @param[in] value la valeur a inserer
+     *
+     *  @exception std::bad_alloc si pas assez de memoire, où toute autre exception lancee par la constructeur de copie de value_type
+     *
+     *  @remark Complexite de O(log n) en moyenne
+     */
+    void push_back( const_reference value ) {
+        insert(value, nbElements);
+    }
+
+public:
+    /**
+     *  @brief accès (lecture/ecriture) a la valeur en tête de SkipList
+     *
+     *  @return reference a cette valeur
+     *
+     *  @exception std::runtime_error si la liste est vide
+     *
+     *  @remark Complexite de O(1)
+     */
+    reference front() {
+        if(!head[0].next) {
+            throw std::runtime_error("SkipList::front");
+        }
+        return head[0].next->data;
+    }
+
+    const_reference front() const {
+        return static_cast<const_reference>(const_cast<SkipList*>(this)->front());
+    }
+
+public:
+    /**
+     *  @brief Suppression de l'element en tête de SkipList
+     *
+     *  @exception std::runtime_error si la liste est vide
+     *
+     *  @remark Complexite de O(log n) en moyenne
+     */
+    void pop_front() {
+        if(!head[0].next) {
+            throw std::runtime_error("SkipList::pop_front");
+        }
+
+        removeAt(0);
+    }
+
+public:
+    /**
+     *  @brief Insertion en position quelconque
+     *
+     *  @param[in] value la valeur a inserer
+     *  @param[in] pos   la position où inserer, 0 est la position en tete
+     *
+     *  @exception std::out_of_range("SkipList::insert") si pos non valide
+     *
+     *  @exception std::bad_alloc si pas assez de memoire, où toute autre exception lancee
+     *              par la constructeur de copie de value_type
+     *
+     *  @remark Complexite de O(log n) en moyenne, n etant la taille de la liste
+     */
+    void insert( const_reference value, size_t pos ) {
+        if(pos > nbElements)
+            throw std::out_of_range("SkipList::insert");
+
+        Link* update[MAX_LEVEL];
+        size_t rank[MAX_LEVEL];
+        descend(pos, update, rank);
+
+        int height = randomHeight();
+        Node* node = newNode(height, value);
+        Link* links = node->links();
+
+        // Nouveaux etages : la tete enjambe toute la liste
+        for(; levels < height; levels++) {
+            head[levels].next = nullptr;
+            head[levels].span = nbElements;
+            update[levels] = head;
+            rank[levels] = 0;
+        }
+
+        for(int i = 0; i < height; i++) {
+            Link& before = update[i][i];
+            links[i].next = before.next;
+            links[i].span = before.span - (pos - rank[i]);
+            before.next = node;
+            before.span = pos - rank[i] + 1;
+        }
+
+        // Etages plus hauts que le maillon : il est enjambe
+        for(int i = height; i < levels; i++) {
+            update[i][i].span++;
+        }
+
+        ++nbElements;
+    }
+
+public:
+    /**
+     *  @brief Acces a l'element en position quelconque
+     *
+     *  @param[in] pos la position, 0 est la position en tete
+     *
+     *  @exception std::out_of_range("SkipList::at") si pos non valide
+     *
+     *  @return une reference a l'element correspondant dans la liste
+     *
+     *  @remark Complexite de O(log n) en moyenne, n etant la taille de la liste
+     */
+    reference at( size_t pos ) {
+        if(pos >= nbElements)
+            throw std::out_of_range("SkipList::at");
+
+        // Descente jusqu'au maillon de rang pos + 1 (la tete est au rang 0)
+        Link* links = head;
+        Node* node = nullptr;
+        size_t rank = 0;
+        for(int i = levels - 1; i >= 0 && rank <= pos; i--) {
+            while(links[i].next && rank + links[i].span <= pos + 1) {
+                rank += links[i].span;
+                node = links[i].next;
+                links = node->links();
+            }
+        }
+
+        return node->data;
+    }
+
+    /**
+     *  @brief Acces a l'element en position quelconque
+     *
+     *  @param[in] pos la position, 0 est la position en tete
+     *
+     *  @exception std::out_of_range("SkipList::at") si pos non valide
+     *
+     *  @return une const_reference a l'element correspondant dans la liste
+     *
+     *  @remark Complexite de O(log n) en moyenne, n etant la taille de la liste
+     */
+    const_reference at( size_t pos ) const {
+        return static_cast<const_reference>(const_cast<SkipList*>(this)->at(pos));
+    }
+
+public:
+    /**
+     *  @brief Suppression en position quelconque
+     *
+     *  @param[in] pos la position, 0 est la position en tete
+     *
+     *  @exception std::out_of_range("SkipList::erase") si pos non valide
+     *
+     *  @remark Complexite de O(log n) en moyenne, n etant la taille de la liste
+     */
+    void erase( size_t pos ) {
+        if(pos >= nbElements)
+            throw std::out_of_range("SkipList::erase");
+
+        removeAt(pos);
+    }
+
+public:
+    /**
+     *  @brief Recherche du premier element correspondant
+     a une valeur donnee dans la liste
+     *
+     *  @param[in] value la valeur a chercher
+     *
+     *  @return la position dans la liste. -1 si la valeur n'est pas trouvee
+     *
+     *  @remark Complexite de O(n), n etant la taille de la liste
+     */
+    size_t find( const_reference value ) const noexcept {
+        size_t pos = 0;
+
+        for(Node* current = head[0].next; current; current = current->next()) {
+            if(current->data == value)
+                return pos;
+            ++pos;
+        }
+
+        return -1;
+    }
+
+    /**
+     *  @brief Tri des elements de la liste par tri fusion
+     *
+     *  Le premier etage est trie en rechainant les maillons, puis les etages
+     *  superieurs sont reconstruits en un passage, chaque maillon gardant sa hauteur.
+     *
+     *  @remark Complexite de O(n*log(n)), n etant la taille de la liste
+     */
+    void sort() noexcept {
+        head[0].next = mergeSort(head[0].next, nbElements);
+        relink();
+    }
+
+private:
+    /**
+     * @brief Descente vers la position pos : pour chaque etage, tour du dernier
+     *        maillon avant pos et son rang (la tete est au rang 0)
+     *
+     * @param[in]  pos    position visee, entre 0 et nbElements
+     * @param[out] update tour du predecesseur a chaque etage
+     * @param[out] rank   rang de ce predecesseur
+     *
+     * @remark Complexite de O(log n) en moyenne
+     */
+    void descend( size_t pos, Link** update, size_t* rank ) noexcept {
+        Link* links = head;
+        size_t r = 0;
+
+        for(int i = levels - 1; i >= 0; i--) {
+            while(links[i].next && r + links[i].span <= pos) {
+                r += links[i].span;
+                links = links[i].next->links();
+            }
+            update[i] = links;
+            rank[i] = r;
+        }
+    }
+
+    /**
+     * @brief Supprime le maillon en position pos
+     *
+     * Fonction pure qui ne test pas les valeurs d'entrés, il est nécessaire
+     *  que les testes soit effecutés en amont
+     *
+     * @remark Complexite de O(log n) en moyenne
+     */
+    void removeAt( size_t pos ) noexcept {
+        assert(pos < nbElements);
+
+        Link* update[MAX_LEVEL] = { head };
+        size_t rank[MAX_LEVEL];
+        descend(pos, update, rank);
+
+        Node* node = update[0][0].next;
+        Link* links = node->links();
+
+        for(int i = 0; i < levels; i++) {
+            Link& before = update[i][i];
+            if(before.next == node) {
+                before.span += links[i].span - 1;
+                before.next = links[i].next;
+            } else {
+                before.span--;
+            }
+        }
+
+        while(levels > 1 && !head[levels - 1].next) {
+            levels--;
+        }
+
+        deleteNode(node);
+        --nbElements;
+    }
+
+    /**
+     * @brief Reconstruit les etages superieurs a partir du premier
+     *
+     * @remark Complexite de O(n), n etant la taille de la liste
+     */
+    void relink() noexcept {
+        Link* last[MAX_LEVEL];
+        size_t lastRank[MAX_LEVEL];
+
+        levels = 1;
+        for(int i = 0; i < MAX_LEVEL; i++) {
+            last[i] = head;
+            lastRank[i] = 0;
+        }
+
+        size_t rank = 0;
+        for(Node* node = head[0].next; node; node = node->next()) {
+            ++rank;
+            Link* links = node->links();
+            for(int i = 0; i < node->height; i++) {
+                last[i][i].next = node;
+                last[i][i].span = rank - lastRank[i];
+                last[i] = links;
+                lastRank[i] = rank;
+            }
+            if(node->height > levels) {
+                levels = node->height;
+            }
+        }
+
+        for(int i = 0; i < levels; i++) {
+            last[i][i].next = nullptr;
+            last[i][i].span = rank - lastRank[i];
+        }
+    }
+
+    /**
+     * @brief Trie par fusion du premier etage
+     *
+     * @param[in] start premier maillon de la chaine
+     * @param[in] size  nombre de maillons de la chaine
+     *
+     * @return premier maillon de la chaine triee, terminee par nullptr
+     *
+     * @remark Complexite de O(n*log(n)), n etant la taille de la chaine
+     */
+    static Node* mergeSort( Node* start, size_t size ) noexcept {
+        if(size <= 1) {
+            if(start) start->links()[0].next = nullptr;
+            return start;
+        }
+
+        Node* half = start;
+        for(size_t i = 0; i < size / 2; i++) {
+            half = half->next();
+        }
+
+        Node* first  = mergeSort(start, size / 2);
+        Node* second = mergeSort(half, size - size / 2);
+
+        // Fusion stable : en cas d'egalite, la moitie gauche d'abord
+        Link sentinel = { nullptr, 0 };
+        Link* current = &sentinel;
+        while(first && second) {
+            if(second->data < first->data) {
+                current->next = second;
+                second = second->next();
+            } else {
+                current->next = first;
+                first = first->next();
+            }
+            current = current->next->links();
+        }
+        current->next = first ? first : second;
+
+        return sentinel.next;
+    }
+
+    /**
+     * @brief Hauteur aleatoire d'une tour, geometrique de raison 1/4
+     *
+     * @remark Complexite de O(1)
+     */
+    int randomHeight() noexcept {
+        seed ^= seed << 13;
+        seed ^= seed >> 7;
+        seed ^= seed << 17;
+
+        uint64_t bits = seed;
+        int height = 1;
+        while(height < MAX_LEVEL && (bits & 3) == 0) {
+            ++height;
+            bits >>= 2;
+        }
+        return height;
+    }
+
+    /**
+     * @brief Construction d'un maillon suivi de sa tour de height liens
+     *
+     * @exception std::bad_alloc si pas assez de memoire, où toute autre exception lancee
+     *              par le constructeur de value_type
+     *
+     * @remark Complexite de O(1)
+     */
+    template <typename... Args>
+    static Node* newNode( int height, Args&&... args ) {
+        void* memory = ::operator new(Node::linksOffset() + size_t(height) * sizeof(Link));
+        try {
+            return new(memory) Node(height, std::forward<Args>(args)...);
+        } catch(...) {
+            ::operator delete(memory);
+            throw;
+        }
+    }
+
+    /**
+     * @brief Destruction d'un maillon construit par newNode
+     *
+     * @remark Complexite de O(1)
+     */
+    static void deleteNode( Node* node ) noexcept {
+        node->~Node();
+        ::operator delete(node);
+    }
+};
+
+template <typename T, typename Trace>
+ostream& operator << ( ostream& os, const SkipList<T, Trace>& liste ) {
+    os << liste.size() << ": ";
+
+    for(auto n = liste.head[0].next; n; n = n->next()) {
+        os << n->data << " ";
+    }
+
+    return os;
+}
+
+#endif
@@ -0,0 +1,906 @@
+//
+//  UnrolledList.cpp
+//
+//  Jonathan Zaehringer
+//  Jorge-Andre Fulgencio Esteves
+//  Florian Schaufelberger
+//
+
+#ifndef _UNROLLED_LIST_CPP_
+#define _UNROLLED_LIST_CPP_
+
+#include <iostream>
+#include <stdexcept>
+#include <cassert>
+#include <algorithm>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+#include "linked_list.cpp"
+
+/**
+ * @brief Nombre d'elements par maillon pour qu'un maillon occupe deux lignes de cache
+ */
+template <typename T>
+constexpr size_t unrolledCapacity() {
+    return (2 * 64 - 2 * sizeof(void*)) / sizeof(T) > 1 ? (2 * 64 - 2 * sizeof(void*)) / sizeof(T) : 1;
+}
+
+/// Forward declaration classe
+template < typename T, typename Trace = NoTrace, size_t Capacity = unrolledCapacity<T>() > class UnrolledList;
+
+/// Forward declaration fonction d'affichage
+template <typename T, typename Trace, size_t Capacity>
+ostream& operator << (ostream& os, const UnrolledList<T, Trace, Capacity>& liste);
+
+/**
+ * Liste chainee deroulee, meme interface que LinkedList
+ *
+ * Chaque maillon contient jusqu'a Capacity elements contigus : les parcours
+ * (find, affichage, tri) suivent un pointeur par maillon plutot que par
+ * element. Un maillon plein est coupe en deux a l'insertion, et un maillon
+ * a moitie vide absorbe son suivant a la suppression si les deux tiennent
+ * dans un seul.
+ *
+ * Trace est appelee a l'insertion et a la suppression de chaque element ;
+ * les deplacements internes aux maillons ne sont pas traces.
+ */
+template < typename T, typename Trace, size_t Capacity > class UnrolledList {
+    static_assert(Capacity > 0, "UnrolledList : un maillon contient au moins un element");
+
+    /**
+     * @brief Surcharge de l'operateur de flux (<size>: <element1> <element2> ...)
+     *
+     * @param[in,out] os flux de sortie utilise par l'envoi
+     * @param[in] liste UnrolledList a afficher
+     *
+     * @return flux de sortie recu pour chainage
+     *
+     * @remark Complexite de O(n), n etant la taille de la liste
+     */
+    friend ostream& operator << <T, Trace, Capacity>(ostream& os, const UnrolledList<T, Trace, Capacity>& liste);
+
+public:
+    using value_type = T;
+    using reference = T&;
+    using const_reference = const T&;
+    using pointer = T*;
+    using const_pointer = const T*;
+
+private:
+    /**
+     *  @brief Maillon de la chaine.
+     *
+     * contient jusqu'a Capacity valeurs contigues et le lien vers le maillon suivant.
+     */
+    struct Node {
+        Node* next;
+        size_t count;
+        typename aligned_storage<sizeof(T) * Capacity, alignof(T)>::type storage;
+
+        Node() noexcept : next(nullptr), count(0) {
+        }
+
+        Node(Node&) = delete;
+        Node(Node&&) = delete;
+
+        pointer items() noexcept {
+            return reinterpret_cast<pointer>(&storage);
+        }
+    };
+
+private:
+    /**
+     *  @brief  Tete de la UnrolledList
+     */
+    Node* head;
+
+private:
+    /**
+     *  @brief  Dernier maillon, nullptr si la liste est vide
+     */
+    Node* last;
+
+private:
+    /**
+     *  @brief Nombre d'elements
+     */
+    size_t nbElements;
+
+public:
+    /**
+     *  @brief Constructeur par defaut. Construit une UnrolledList vide
+     *
+     *  @remark Complexite de O(1)
+     */
+    UnrolledList() : head(nullptr), last(nullptr), nbElements(0) {
+    }
+
+public:
+    /**
+     *  @brief Constructeur de copie, les maillons de la copie sont pleins
+     *
+     *  @param[in] other la UnrolledList a copier
+     *
+     *  @remark Complexite de O(n), n etant la taille de la liste a copier
+     */
+    UnrolledList( const UnrolledList& other ) : UnrolledList() {
+        for(Node* node = other.head; node; node = node->next) {
+            for(size_t i = 0; i < node->count; i++) {
+                push_back(node->items()[i]);
+            }
+        }
+    }
+
+public:
+    /**
+     *  @brief Constructeur de deplacement
+     *
+     *  @param[in,out] other la UnrolledList dont les maillons sont repris, vide ensuite
+     *
+     *  @remark Complexite de O(1)
+     */
+    UnrolledList( UnrolledList&& other ) noexcept : UnrolledList() {
+        swap(other);
+    }
+
+public:
+    /**
+     *  @brief Operateur d'affectation par copie
+     *
+     *  @param[in] other la UnrolledList a copier
+     *
+     *  @return la UnrolledList courante *this (par reference)
+     *
+     *  @remark Complexite de O(n), n etant la taille de la liste a copier
+     */
+    UnrolledList& operator= ( const UnrolledList& other ) {
+        if(this != &other) {
+            UnrolledList tmp(other);
+            swap(tmp);
+        }
+
+        return *this;
+    }
+
+    /**
+     *  @brief Operateur d'affectation par deplacement
+     *
+     *  @param[in,out] other la UnrolledList dont les maillons sont repris, vide ensuite
+     *
+     *  @return la UnrolledList courante *this (par reference)
+     *
+     *  @remark Complexite de O(1), plus la liberation du contenu precedent
+     */
+    UnrolledList& operator= ( UnrolledList&& other ) noexcept {
+        UnrolledList tmp(std::move(other));
+        swap(tmp);
+
+        return *this;
+    }
+
+public:
+    /**
+     *  @brief Echange du contenu de deux UnrolledList
+     *
+     *  @remark Complexite de O(1)
+     */
+    void swap( UnrolledList& other ) noexcept {
+        using std::swap;
+        swap(head, other.head);
+        swap(last, other.last);
+        swap(nbElements, other.nbElements);
+    }
+
+public:
+    /**
+     *  @brief destructeur
+     *
+     *  @remark Complexite de O(n), n etant la taille de la liste
+     */
+    ~UnrolledList() {
+        clear();
+    }
+
+public:
+    /**
+     *  @brief Suppression de tous les elements
+     *
+     *  @remark Complexite de O(n), n etant la taille de la liste
+     */
+    void clear() noexcept {
+        while(head) {
+            Node* next = head->next;
+            for(size_t i = 0; i < head->count; i++) {
+                Trace::destroyed(head->items()[i]);
+                head->items()[i].~value_type();
+            }
+            delete head;
+            head = next;
+        }
+
+        last = nullptr;
+        nbElements = 0;
+    }
+
+public:
+    /**
+     *  @brief nombre d'elements stockes dans la liste
+     *
+     *  @return nombre d'elements.
+     *
+     *  @remark Complexite de O(1)
+     */
+    size_t size() const noexcept {
+        return nbElements;
+    }
+
+public:
+    /**
+     *  @brief insertion d'une valeur en tête de liste
+     *
+     *  @param[in] value la valeur a inserer
+     *
+     *  @exception std::bad_alloc si pas assez de memoire, où toute autre exception lancee par la constructeur de copie de value_type
+     *
+     *  @remark Complexite de O(Capacity)
+     */
+    void push_front( const_reference value ) {
+        emplace(0, value);
+    }
+
+    /**
+     *  @brief insertion d'une valeur en queue de liste
+     *
+     *  @param[in] value la valeur a inserer
+     *
+     *  @exception std::bad_alloc si pas assez de memoire, où toute autre exception lancee par la constructeur de copie de value_type
+     *
+     *  @remark Complexite de O(1)
+     */
+    void push_back( const_reference value ) {
+        emplace(nbElements, value);
+    }
+
+    /**
+     *  @brief insertion d'une valeur en tête de liste, par deplacement
+     *
+     *  @param[in,out] value la valeur a inserer, deplacee
+     *
+     *  @exception std::bad_alloc si pas assez de memoire, où toute autre exception lancee par la constructeur de deplacement de value_type
+     *
+     *  @remark Complexite de O(Capacity)
+     */
+    void push_front( value_type&& value ) {
+        emplace(0, std::move(value));
+    }
+
+    /**
+     *  @brief insertion d'une valeur en queue de liste, par deplacement
+     *
+     *  @param[in,out] value la valeur a inserer, deplacee
+     *
+     *  @exception std::bad_alloc si pas assez de memoire, où toute autre exception lancee par la constructeur de deplacement de value_type
+     *
+     *  @remark Complexite de O(1)
+     */
+    void push_back( value_type&& value ) {
+        emplace(nbElements, std::move(value));
+    }
+
+    /**
+     *  @brief Construction d'une valeur en tête de liste
+     *
+     *  @param[in] args arguments transmis au constructeur de value_type
+     *
+     *  @exception std::bad_alloc si pas assez de memoire, où toute autre exception lancee par la constructeur de value_type
+     *
+     *  @remark Complexite de O(Capacity)
+     */
+    template <typename... Args>
+    void emplace_front( Args&&... args ) {
+        emplace(0, std::forward<Args>(args)...);
+    }
+
+    /**
+     *  @brief Construction d'une valeur en queue de liste
+     *
+     *  @param[in] args arguments transmis au constructeur de value_type
+     *
+     *  @exception std::bad_alloc si pas assez de memoire, où toute autre exception lancee par la constructeur de value_type
+     *
+     *  @remark Complexite de O(1)
+     */
+    template <typename... Args>
+    void emplace_back( Args&&... args ) {
+        emplace(nbElements, std::forward<Args>(args)...);
+    }
+
+public:
+    /**
+     *  @brief accès (lecture/ecriture) a la valeur en tête de UnrolledList
+     *
+     *  @return reference a cette valeur
+     *
+     *  @exception std::runtime_error si la liste est vide
+     *
+     *  @remark Complexite de O(1)
+     */
+    reference front() {
+        if(!head) {
+            throw std::runtime_error("UnrolledList::front");
+        }
+        return head->items()[0];
+    }
+
+    const_reference front() const {
+        return static_cast<const_reference>(const_cast<UnrolledList*>(this)->front());
+    }
+
+public:
+    /**
+     *  @brief Suppression de l'element en tête de UnrolledList
+     *
+     *  @exception std::runtime_error si la liste est vide
+     *
+     *  @remark Complexite de O(Capacity)
+     */
+    void pop_front() {
+        if(!head) {
+            throw std::runtime_error("UnrolledList::pop_front");
+        }
+
+        removeAt(nullptr, head, 0);
+    }
+
+public:
+    /**
+     *  @brief Insertion en position quelconque
+     *
+     *  @param[in] value la valeur a inserer
+     *  @param[in] pos   la position où inserer, 0 est la position en tete
+     *
+     *  @exception std::out_of_range("UnrolledList::insert") si pos non valide
+     *
+     *  @exception std::bad_alloc si pas assez de memoire, où toute autre exception lancee
+     *              par la constructeur de copie de value_type
+     *
+     *  @remark Complexite de O(n / Capacity + Capacity), n etant la taille de la liste ; O(1) en queue
+     */
+    void insert( const_reference value, size_t pos ) {
+        emplace(pos, value);
+    }
+
+    /**
+     *  @brief Insertion en position quelconque, par deplacement
+     *
+     *  @param[in,out] value la valeur a inserer, deplacee
+     *  @param[in]     pos   la position où inserer, 0 est la position en tete
+     *
+     *  @exception std::out_of_range("UnrolledList::insert") si pos non valide
+     *
+     *  @exception std::bad_alloc si pas assez de memoire, où toute autre exception lancee
+     *              par la constructeur de deplacement de value_type
+     *
+     *  @remark Complexite de O(n / Capacity + Capacity), n etant la taille de la liste ; O(1) en queue
+     */
+    void insert( value_type&& value, size_t pos ) {
+        emplace(pos, std::move(value));
+    }
+
+    /**
+     *  @brief Construction d'une valeur en position quelconque
+     *
+     *  @param[in] pos  la position où inserer, 0 est la position en tete
+     *  @param[in] args arguments transmis au constructeur de value_type
+     *
+     *  @exception std::out_of_range("UnrolledList::insert") si pos non valide
+     *
+     *  @exception std::bad_alloc si pas assez de memoire, où toute autre exception lancee
+     *              par la constructeur de value_type
+     *
+     *  @remark Complexite de O(n / Capacity + Capacity), n etant la taille de la liste ; O(1) en queue
+     */
+    template <typename... Args>
+    void emplace( size_t pos, Args&&... args ) {
+        if(pos > nbElements)
+            throw std::out_of_range("UnrolledList::insert");
+
+        // Valeur construite avant tout deplacement : args peut designer un element de la liste
+        value_type value(std::forward<Args>(args)...);
+        Node* node;
+        size_t index;
+
+        if(pos == nbElements) {
+            if(!last || last->count == Capacity) {
+                appendNode();
+            }
+            node = last;
+            index = last->count;
+        } else {
+            Node* previous;
+            locate(pos, previous, node, index);
+
+            if(node->count == Capacity) {
+                split(node);
+                if(index > node->count) {
+                    index -= node->count;
+                    node = node->next;
+                }
+            }
+        }
+
+        insertAt(node, index, std::move(value));
+        ++nbElements;
+    }
+
+public:
+    /**
+     *  @brief Deplacement de tous les maillons de other en queue de liste
+     *
+     *  Les maillons sont chaines tels quels, sans deplacer de valeur ni les
+     *  tracer : le dernier maillon de la liste peut rester incomplet.
+     *
+     *  @param[in,out] other la UnrolledList dont les maillons sont repris, vide ensuite
+     *
+     *  @remark Complexite de O(1)
+     */
+    void splice( UnrolledList& other ) noexcept {
+        if(this == &other || !other.head) {
+            return;
+        }
+
+        (last ? last->next : head) = other.head;
+        last = other.last;
+        nbElements += other.nbElements;
+
+        other.head = nullptr;
+        other.last = nullptr;
+        other.nbElements = 0;
+    }
+
+    void splice( UnrolledList&& other ) noexcept {
+        splice(other);
+    }
+
+public:
+    /**
+     *  @brief Copie des elements d'une autre liste en queue de liste
+     *
+     *  @param[in] other la UnrolledList a copier, eventuellement la liste courante
+     *
+     *  @exception std::bad_alloc si pas assez de memoire, où toute autre exception lancee
+     *              par la constructeur de copie de value_type ; les elements deja
+     *              copies restent alors dans la liste
+     *
+     *  @remark Complexite de O(m), m etant la taille de other
+     */
+    void append( const UnrolledList& other ) {
+        // Nombre fixe a l'avance : other peut etre la liste courante. Un ajout
+        // en queue ne deplace aucun element deja present
+        size_t remaining = other.nbElements;
+        for(Node* node = other.head; remaining > 0; node = node->next) {
+            for(size_t i = 0; i < node->count && remaining > 0; i++, remaining--) {
+                emplace(nbElements, node->items()[i]);
+            }
+        }
+    }
+
+    /**
+     *  @brief Copie des elements de [first, last) en queue de liste
+     *
+     *  @param[in] first debut de l'intervalle
+     *  @param[in] end   fin de l'intervalle (exclue)
+     *
+     *  @exception std::bad_alloc si pas assez de memoire, où toute autre exception lancee
+     *              par la constructeur de value_type
+     *
+     *  @remark Complexite de O(m), m etant la taille de l'intervalle
+     */
+    template <typename InputIt>
+    void append( InputIt first, InputIt end ) {
+        for(; first != end; ++first) {
+            emplace(nbElements, *first);
+        }
+    }
+
+public:
+    /**
+     *  @brief Acces a l'element en position quelconque
+     *
+     *  @param[in] pos la position, 0 est la position en tete
+     *
+     *  @exception std::out_of_range("UnrolledList::at") si pos non valide
+     *
+     *  @return une reference a l'element correspondant dans la liste
+     *
+     *  @remark Complexite de O(n / Capacity), n etant la taille de la liste
+     */
+    reference at( size_t pos ) {
+        if(pos >= nbElements)
+            throw std::out_of_range("UnrolledList::at");
+
+        Node* previous;
+        Node* node;
+        size_t index;
+        locate(pos, previous, node, index);
+
+        return node->items()[index];
+    }
+
+    /**
+     *  @brief Acces a l'element en position quelconque
+     *
+     *  @param[in] pos la position, 0 est la position en tete
+     *
+     *  @exception std::out_of_range("UnrolledList::at") si pos non valide
+     *
+     *  @return une const_reference a l'element correspondant dans la liste
+     *
+     *  @remark Complexite de O(n / Capacity), n etant la taille de la liste
+     */
+    const_reference at( size_t pos ) const {
+        return static_cast<const_reference>(const_cast<UnrolledList*>(this)->at(pos));
+    }
+
+public:
+    /**
+     *  @brief Suppression en position quelconque
+     *
+     *  @param[in] pos la position, 0 est la position en tete
+     *
+     *  @exception std::out_of_range("UnrolledList::erase") si pos non valide
+     *
+     *  @remark Complexite de O(n / Capacity + Capacity), n etant la taille de la liste
+     */
+    void erase( size_t pos ) {
+        if(pos >= nbElements)
+            throw std::out_of_range("UnrolledList::erase");
+
+        Node* previous;
+        Node* node;
+        size_t index;
+        locate(pos, previous, node, index);
+
+        removeAt(previous, node, index);
+    }
+
+public:
+    /**
+     *  @brief Recherche du premier element correspondant
+     a une valeur donnee dans la liste
+     *
+     *  Chaque maillon est d'abord teste en entier sans sortie anticipee, boucle
+     *  que le compilateur peut vectoriser ; la position exacte n'est cherchee
+     *  que dans le maillon qui contient la valeur.
+     *
+     *  @param[in] value la valeur a chercher
+     *
+     *  @return la position dans la liste. -1 si la valeur n'est pas trouvee
+     *
+     *  @remark Complexite de O(n), n etant la taille de la liste
+     */
+    size_t find( const_reference value ) const noexcept {
+        size_t pos = 0;
+
+        for(Node* node = head; node; node = node->next) {
+            const_pointer items = node->items();
+            const size_t count = node->count;
+
+            bool found = false;
+            for(size_t i = 0; i < count; i++) {
+                found |= items[i] == value;
+            }
+
+            if(found) {
+                return pos + size_t(std::find(items, items + count, value) - items);
+            }
+            pos += count;
+        }
+
+        return -1;
+    }
+
+    /**
+     *  @brief Tri stable des elements de la liste par fusion de maillons
+     *
+     *  Chaque maillon est d'abord trie par insertion et forme une sequence ;
+     *  les sequences sont fusionnees au fil de l'eau dans des casiers ou le
+     *  casier i regroupe environ 2^i maillons, comme LinkedList::sort. Une
+     *  fusion remplit ses maillons jusqu'a Capacity et recycle chaque maillon
+     *  source des qu'il est vide : deux maillons d'avance suffisent, alloues
+     *  avant de toucher a la liste.
+     *
+     *  @exception std::bad_alloc si pas assez de memoire pour ces deux
+     *              maillons ; la liste est alors inchangee
+     *
+     *  @remark les comparaisons et les deplacements de value_type ne doivent
+     *          pas lever d'exception
+     *
+     *  @remark Complexite de O(n*log(n)), n etant la taille de la liste, et
+     *          O(Capacity) de memoire temporaire
+     */
+    void sort() {
+        if(!head) {
+            return;
+        }
+
+        Node* spare = nullptr;
+        if(head != last) {
+            spare = new Node();
+            try {
+                spare->next = new Node();
+            } catch(...) {
+                delete spare;
+                throw;
+            }
+        }
+
+        Run bins[sizeof(size_t) * 8] = {};
+        const size_t nbBins = sizeof(bins) / sizeof(bins[0]);
+        size_t used = 0;
+
+        for(Node* node = head; node;) {
+            Run run = { node, node };
+            node = node->next;
+            run.last->next = nullptr;
+            sortNode(run.first);
+
+            // Propagation comme une retenue : les casiers pleins contiennent des elements anterieurs
+            size_t i = 0;
+            for(; i < used && bins[i].first; i++) {
+                run = merge(bins[i], run, spare);
+                bins[i].first = nullptr;
+            }
+            if(i == nbBins) {
+                --i;
+            }
+            bins[i] = run;
+            if(i == used) {
+                ++used;
+            }
+        }
+
+        Run sorted = { nullptr, nullptr };
+        for(size_t i = 0; i < used; i++) {
+            if(bins[i].first) {
+                sorted = sorted.first ? merge(bins[i], sorted, spare) : bins[i];
+            }
+        }
+        head = sorted.first;
+        last = sorted.last;
+
+        while(spare) {
+            Node* next = spare->next;
+            delete spare;
+            spare = next;
+        }
+    }
+
+private:
+    /**
+     * @brief Sequence triee de maillons, terminee par nullptr ; tous ses
+     *        maillons sont pleins sauf peut-etre le dernier
+     */
+    struct Run {
+        Node* first;
+        Node* last;
+    };
+
+    /**
+     * @brief Tri stable par insertion des elements d'un maillon
+     *
+     * @remark Complexite de O(Capacity^2)
+     */
+    static void sortNode( Node* node ) {
+        pointer items = node->items();
+
+        for(size_t i = 1; i < node->count; i++) {
+            if(items[i] < items[i - 1]) {
+                value_type value(std::move(items[i]));
+                size_t j = i;
+                do {
+                    items[j] = std::move(items[j - 1]);
+                    --j;
+                } while(j > 0 && value < items[j - 1]);
+                items[j] = std::move(value);
+            }
+        }
+    }
+
+    /**
+     * @brief Fusion stable de deux sequences, left precedant right
+     *
+     * Les valeurs sont deplacees dans des maillons pris dans spare, remplis
+     * jusqu'a Capacity ; chaque maillon source vide y retourne aussitot.
+     * Tant que les maillons sources sont pleins (sauf le dernier de chaque
+     * sequence), les maillons recycles ont au plus deux de retard sur ceux
+     * consommes : deux maillons dans spare suffisent.
+     *
+     * @param[in,out] spare pile de maillons vides, chaines par next
+     *
+     * @remark Complexite de O(n), n etant le nombre d'elements des deux sequences
+     */
+    static Run merge( Run left, Run right, Node*& spare ) {
+        Run merged = { nullptr, nullptr };
+        Node* sources[2] = { left.first, right.first };
+        size_t indexes[2] = { 0, 0 };
+
+        while(sources[0] || sources[1]) {
+            // A egalite, left d'abord : la fusion reste stable
+            const size_t s = !sources[0] || (sources[1] && sources[1]->items()[indexes[1]] < sources[0]->items()[indexes[0]]);
+            Node* source = sources[s];
+
+            if(!merged.last || merged.last->count == Capacity) {
+                assert(spare);
+                Node* node = spare;
+                spare = node->next;
+                node->next = nullptr;
+                (merged.last ? merged.last->next : merged.first) = node;
+                merged.last = node;
+            }
+
+            pointer item = source->items() + indexes[s];
+            ::new(static_cast<void*>(merged.last->items() + merged.last->count)) value_type(std::move(*item));
+            item->~value_type();
+            ++merged.last->count;
+
+            if(++indexes[s] == source->count) {
+                sources[s] = source->next;
+                indexes[s] = 0;
+                source->count = 0;
+                source->next = spare;
+                spare = source;
+            }
+        }
+
+        return merged;
+    }
+
+    /**
+     * @brief Recherche du maillon contenant la position pos
+     *
+     * @param[in]  pos      position entre 0 et nbElements - 1
+     * @param[out] previous maillon precedent, nullptr en tete
+     * @param[out] node     maillon contenant pos
+     * @param[out] index    indice de pos dans ce maillon
+     *
+     * @remark Complexite de O(n / Capacity)
+     *
+     * Fonction pure qui ne test pas les valeurs d'entrés, il est nécessaire
+     *  que les testes soit effecutés en amont
+     */
+    void locate( size_t pos, Node*& previous, Node*& node, size_t& index ) const noexcept {
+        assert(pos < nbElements);
+
+        previous = nullptr;
+        node = head;
+        while(pos >= node->count) {
+            pos -= node->count;
+            previous = node;
+            node = node->next;
+        }
+        index = pos;
+    }
+
+    /**
+     * @brief Ajoute un maillon vide en queue
+     *
+     * @exception std::bad_alloc si pas assez de memoire
+     *
+     * @remark Complexite de O(1)
+     */
+    void appendNode() {
+        Node* node = new Node();
+        if(last) {
+            last->next = node;
+        } else {
+            head = node;
+        }
+        last = node;
+    }
+
+    /**
+     * @brief Coupe un maillon plein : sa seconde moitie passe dans un nouveau maillon suivant
+     *
+     * @exception std::bad_alloc si pas assez de memoire
+     *
+     * @remark Complexite de O(Capacity)
+     */
+    void split( Node* node ) {
+        Node* half = new Node();
+        size_t keep = node->count / 2;
+
+        for(size_t i = keep; i < node->count; i++) {
+            ::new(static_cast<void*>(half->items() + half->count)) value_type(std::move(node->items()[i]));
+            node->items()[i].~value_type();
+            ++half->count;
+        }
+        node->count = keep;
+
+        half->next = node->next;
+        node->next = half;
+        if(last == node) {
+            last = half;
+        }
+    }
+
+    /**
+     * @brief Place value en position index d'un maillon non plein, en decalant la suite
+     *
+     * @remark Complexite de O(Capacity)
+     */
+    void insertAt( Node* node, size_t index, value_type&& value ) {
+        assert(node->count < Capacity && index <= node->count);
+
+        pointer items = node->items();
+        if(index == node->count) {
+            ::new(static_cast<void*>(items + index)) value_type(std::move(value));
+        } else {
+            ::new(static_cast<void*>(items + node->count)) value_type(std::move(items[node->count - 1]));
+            move_backward(items + index, items + node->count - 1, items + node->count);
+            items[index] = std::move(value);
+        }
+        ++node->count;
+
+        Trace::constructed(items[index]);
+    }
+
+    /**
+     * @brief Supprime l'element en position index d'un maillon
+     *
+     * Un maillon vide est libere ; un maillon a moitie vide absorbe son
+     * suivant si les deux tiennent dans un seul.
+     *
+     * @param[in] previous maillon precedent, nullptr en tete
+     *
+     * @remark Complexite de O(Capacity)
+     */
+    void removeAt( Node* previous, Node* node, size_t index ) noexcept {
+        pointer items = node->items();
+
+        Trace::destroyed(items[index]);
+        move(items + index + 1, items + node->count, items + index);
+        items[--node->count].~value_type();
+        --nbElements;
+
+        if(node->count == 0) {
+            (previous ? previous->next : head) = node->next;
+            if(last == node) {
+                last = previous;
+            }
+            delete node;
+            return;
+        }
+
+        Node* next = node->next;
+        if(next && node->count < Capacity / 2 && node->count + next->count <= Capacity) {
+            for(size_t i = 0; i < next->count; i++) {
+                ::new(static_cast<void*>(items + node->count)) value_type(std::move(next->items()[i]));
+                next->items()[i].~value_type();
+                ++node->count;
+            }
+            node->next = next->next;
+            if(last == next) {
+                last = node;
+            }
+            delete next;
+        }
+    }
+};
+
+template <typename T, typename Trace, size_t Capacity>
+ostream& operator << ( ostream& os, const UnrolledList<T, Trace, Capacity>& liste ) {
+    os << liste.size() << ": ";
+
+    for(auto node = liste.head; node; node = node->next) {
+        for(size_t i = 0; i < node->count; i++) {
+            os << node->items()[i] << " ";
+        }
+    }
+
+    return os;
+}
+
+#endif